@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+"""Compare exact and sampled statistics for STDEV_* image scaling.
+
+For each number of samples (0 meaning every pixel), report the time taken to
+determine the scaling, the compressed size of the image and the RMS
+quantization error in units of the noise.
+"""
+
+import argparse
+import os
+import tempfile
+import time
+
+import numpy as np
+
+import lsst.afw.fits
+import lsst.afw.image
+from lsst.afw.fits import ImageCompressionOptions, ImageScalingOptions
+
+
+def makeImage(width, height, noise, seed=12345):
+    """Make an image of sky noise with some bright sources"""
+    rng = np.random.RandomState(seed)
+    image = lsst.afw.image.ImageF(width, height)
+    image.array[:] = rng.normal(1000.0, noise, image.array.shape)
+    radius = 15
+    yy, xx = np.indices((2*radius + 1, 2*radius + 1)) - radius
+    psf = np.exp(-0.5*(xx**2 + yy**2)/4.0)/(2*np.pi*4.0)
+    for _ in range(width*height//10000):
+        x0 = rng.randint(radius, width - radius)
+        y0 = rng.randint(radius, height - radius)
+        flux = rng.uniform(1.0e3, 1.0e6)
+        image.array[y0 - radius:y0 + radius + 1, x0 - radius:x0 + radius + 1] += flux*psf
+    return image
+
+
+def run(image, noise, samplesList, quantizeLevel=10.0, number=5):
+    compression = ImageCompressionOptions(ImageCompressionOptions.RICE, True, 0.0)
+    print("%10s %12s %12s %12s %12s" % ("samples", "time (s)", "bscale", "size (MB)", "error/noise"))
+    for numSamples in samplesList:
+        scaling = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 32, quantizeLevel=quantizeLevel,
+                                      statsSamples=numSamples)
+        start = time.time()
+        for _ in range(number):
+            scale = scaling.determine(image)
+        elapsed = (time.time() - start)/number
+
+        with tempfile.NamedTemporaryFile(suffix=".fits") as temp:
+            image.writeFits(temp.name, lsst.afw.fits.ImageWriteOptions(compression, scaling))
+            size = os.path.getsize(temp.name)
+            readback = lsst.afw.image.ImageF(temp.name)
+        error = np.sqrt(np.mean((readback.array - image.array)**2))/noise
+        print("%10d %12.4f %12.5g %12.3f %12.4f" % (numSamples, elapsed, scale.bscale, size/2**20, error))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--width", type=int, default=4096, help="Image width")
+    parser.add_argument("--height", type=int, default=4096, help="Image height")
+    parser.add_argument("--noise", type=float, default=10.0, help="Sky noise")
+    parser.add_argument("--samples", type=int, nargs="*", default=[0, 1000, 10000, 100000, 1000000],
+                        help="Numbers of samples to try (0 = all pixels)")
+    args = parser.parse_args()
+    run(makeImage(args.width, args.height, args.noise), args.noise, args.samples)
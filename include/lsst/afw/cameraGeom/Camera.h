@@ -78,6 +78,10 @@ public:
     /**
      * Find the detectors that cover a point in any camera system
      *
+     * Only the detectors whose FOCAL_PLANE footprints (held in a spatial
+     * index built with the Camera) overlap the point are transformed exactly
+     * to PIXELS and tested against their bounding boxes.
+     *
      * @param[in] point  position to use in lookup (lsst::geom::Point2D)
      * @param[in] cameraSys  camera coordinate system of `point`
      * @returns a list of zero or more Detectors that overlap the specified point
@@ -87,13 +91,22 @@ public:
     /**
      * Find the detectors that cover a list of points in any camera system
      *
+     * The points are grouped by candidate detector using the same spatial
+     * index as findDetectors, so each detector needs at most one (batched)
+     * exact transform.
+     *
      * @param[in] pointList  a list of points (lsst::geom::Point2D)
      * @param[in] cameraSys the camera coordinate system of the points in `pointList`
+     * @param[in] nThreads  number of threads over which to divide the
+     *    candidate detectors; the results do not depend on it.
      * @returns a list of lists; each list contains the names of all detectors
      *    which contain the corresponding point
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if `nThreads` is
+     *    less than one.
      */
     std::vector<DetectorList> findDetectorsList(std::vector<lsst::geom::Point2D> const &pointList,
-                                                CameraSys const &cameraSys) const;
+                                                CameraSys const &cameraSys, int nThreads = 1) const;
 
     /**
      * Get a transform from one CameraSys to another
@@ -179,6 +192,9 @@ private:
     // Deserialization factory.
     class Factory;
 
+    // Spatial index of detector footprints in FOCAL_PLANE.
+    class FocalPlaneIndex;
+
     // Constructor used by Camera::Builder.
     // Some arguments passed by value to make moves possible.
     Camera(std::string const & name, DetectorList detectors,
@@ -194,6 +210,7 @@ private:
     std::string _name;
     std::string _pupilFactoryName;
     std::shared_ptr<TransformMap const> _transformMap;
+    std::unique_ptr<FocalPlaneIndex const> _focalPlaneIndex;
 };
 
 
@@ -0,0 +1,90 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_CAMERAGEOM_ASSEMBLEIMAGE_H
+#define LSST_AFW_CAMERAGEOM_ASSEMBLEIMAGE_H
+
+#include "lsst/afw/cameraGeom/Amplifier.h"
+#include "lsst/afw/cameraGeom/Detector.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+/**
+ * Copy the pixels of one amplifier from a raw image into an assembled image.
+ *
+ * The amplifier's raw pixels are flipped as given by Amplifier::getRawFlipX
+ * and Amplifier::getRawFlipY while they are copied.
+ *
+ * @param[in,out] destImage  Image to assemble into.  If `trim` is true, the
+ *     region `amplifier.getBBox()` is overwritten with the amplifier's data
+ *     region; otherwise the region `amplifier.getRawBBox()` shifted by
+ *     `amplifier.getRawXYOffset()` is overwritten with the whole raw
+ *     amplifier (including prescan and overscan).
+ * @param[in] rawImage  Raw image containing the amplifier.
+ * @param[in] amplifier  Amplifier geometry, with raw amplifier info.
+ * @param[in] trim  Whether to copy only the data region of the amplifier.
+ *
+ * @tparam ImageT  An Image, Mask, MaskedImage or Exposure.
+ *
+ * @throws lsst::pex::exceptions::LengthError if the source and destination
+ *     regions differ in size or do not lie within their images.
+ */
+template <typename ImageT>
+void assembleAmplifier(ImageT &destImage, ImageT const &rawImage, Amplifier const &amplifier,
+                       bool trim = true);
+
+/**
+ * Copy the pixels of all amplifiers of a detector from a raw image into an
+ * assembled image.
+ *
+ * This is equivalent to calling assembleAmplifier for each amplifier of
+ * `detector`, but all views are validated before any pixels are copied, and
+ * the copies can be divided between threads (amplifiers never share
+ * destination pixels).
+ *
+ * @param[in,out] destImage  Image to assemble into.
+ * @param[in] rawImage  Raw image containing all amplifiers.
+ * @param[in] detector  Detector whose amplifiers define the geometry.
+ * @param[in] trim  Whether to copy only the data regions of the amplifiers.
+ * @param[in] nThreads  Number of threads over which to divide the amplifiers.
+ *
+ * @tparam ImageT  An Image, Mask, MaskedImage or Exposure.
+ *
+ * @throws lsst::pex::exceptions::LengthError if the source and destination
+ *     regions of any amplifier differ in size or do not lie within their
+ *     images.
+ * @throws lsst::pex::exceptions::InvalidParameterError if `nThreads` is less
+ *     than one.
+ */
+template <typename ImageT>
+void assembleDetector(ImageT &destImage, ImageT const &rawImage, Detector const &detector, bool trim = true,
+                      int nThreads = 1);
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_CAMERAGEOM_ASSEMBLEIMAGE_H
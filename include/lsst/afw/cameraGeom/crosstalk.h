@@ -0,0 +1,82 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_CAMERAGEOM_CROSSTALK_H
+#define LSST_AFW_CAMERAGEOM_CROSSTALK_H
+
+#include <limits>
+
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/cameraGeom/Detector.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+/**
+ * Subtract crosstalk between the amplifiers of a detector, in place.
+ *
+ * For each pair of distinct amplifiers, the image of the victim amplifier
+ * @f$v@f$ is corrected by
+ * @f[
+ *     I_v \leftarrow I_v - \sum_{s \ne v} C_{v,s} \, F_{s \to v}(I_s)
+ * @f]
+ * where @f$C@f$ is `detector.getCrosstalk()` and @f$F_{s \to v}@f$ flips the
+ * source amplifier image so that its readout corner coincides with that of
+ * the victim.  All contributions are computed from the uncorrected image.
+ *
+ * @param[in,out] image  Image to correct; only the image plane of a
+ *     MaskedImage or Exposure is modified.
+ * @param[in] detector  Detector with crosstalk coefficients and amplifier
+ *     geometry.
+ * @param[in] trim  If true, `image` is assembled and trimmed and amplifiers
+ *     occupy Amplifier::getBBox, with readout corners given by
+ *     Amplifier::getReadoutCorner.  If false, `image` is a raw image and
+ *     amplifiers occupy Amplifier::getRawDataBBox, with readout corners
+ *     flipped by Amplifier::getRawFlipX and Amplifier::getRawFlipY.
+ * @param[in] threshold  Only source pixels with values above this threshold
+ *     contribute crosstalk.
+ * @param[in] sourceMask  If nonzero, only source pixels with at least one
+ *     of these mask bits set contribute crosstalk.  Ignored for plain
+ *     images.
+ * @param[in] nThreads  Number of threads over which to divide the victim
+ *     amplifiers; the result does not depend on it.
+ *
+ * @tparam ImageT  An Image, MaskedImage or Exposure.
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if the detector has
+ *     no crosstalk coefficients, or if `nThreads` is less than one.
+ * @throws lsst::pex::exceptions::LengthError if the amplifiers do not all
+ *     have the same dimensions or do not lie within the image.
+ */
+template <typename ImageT>
+void subtractCrosstalk(ImageT &image, Detector const &detector, bool trim = true,
+                       double threshold = -std::numeric_limits<double>::infinity(),
+                       afw::image::MaskPixel sourceMask = 0, int nThreads = 1);
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_CAMERAGEOM_CROSSTALK_H
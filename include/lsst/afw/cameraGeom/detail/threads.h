@@ -0,0 +1,115 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_CAMERAGEOM_DETAIL_THREADS_H
+#define LSST_AFW_CAMERAGEOM_DETAIL_THREADS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "boost/format.hpp"
+#include "lsst/pex/exceptions.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+namespace detail {
+
+/**
+ * Check that a requested number of threads is valid.
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if `nThreads` is less
+ *     than one.
+ */
+inline void checkNumThreads(int nThreads) {
+    if (nThreads < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of threads must be positive; got %d") % nThreads).str());
+    }
+}
+
+/**
+ * Divide the range [0, size) into contiguous blocks and call
+ * `function(begin, end)` on each block in its own thread.
+ *
+ * At most `min(nThreads, size)` threads are used; if that is one or less,
+ * `function(0, size)` is called on the calling thread.  All threads are
+ * joined before this returns, even if starting one of them fails, and the
+ * first exception thrown by `function` in any thread is rethrown here.
+ *
+ * @param[in] size  Number of items to process.
+ * @param[in] nThreads  Maximum number of threads to use.
+ * @param[in] function  Callable taking `(std::size_t begin, std::size_t end)`;
+ *     calls for different blocks may run concurrently.
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if `nThreads` is less
+ *     than one.
+ */
+template <typename Function>
+void parallelForRanges(std::size_t size, int nThreads, Function const &function) {
+    checkNumThreads(nThreads);
+    std::size_t const nWorkers = std::min(static_cast<std::size_t>(nThreads), size);
+    if (nWorkers <= 1) {
+        function(std::size_t(0), size);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(nWorkers);
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+    auto joinAll = [&threads]() {
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    };
+    try {
+        for (std::size_t i = 0; i < nWorkers; ++i) {
+            threads.emplace_back([&function, &errors, i, size, nWorkers]() {
+                try {
+                    function((i * size) / nWorkers, ((i + 1) * size) / nWorkers);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    } catch (...) {
+        joinAll();
+        throw;
+    }
+    joinAll();
+    for (auto const &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_CAMERAGEOM_DETAIL_THREADS_H
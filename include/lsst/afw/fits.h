@@ -14,8 +14,10 @@
  */
 
 #include <climits>
+#include <functional>
 #include <string>
 #include <set>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -254,12 +256,14 @@ struct ImageWriteOptions {
     /// * scaling.quantizePad: number of stdev to allow on the low side (for STDEV_POSITIVE/NEGATIVE)
     /// * scaling.bscale: manually specified BSCALE (for MANUAL scaling)
     /// * scaling.bzero: manually specified BSCALE (for MANUAL scaling)
+    /// * scaling.statsSamples (int): number of pixels to sample for STDEV_* statistics (0 = all)
     ///
     /// Use the 'validate' method to set default values for the above.
     ///
-    /// 'scaling.maskPlanes' is the only entry that is allowed to be missing
-    /// (because PropertySet can't represent an empty array); when it is missing,
-    /// it is interpreted as an empty array.
+    /// 'scaling.maskPlanes' may be missing (because PropertySet can't represent an
+    /// empty array); when it is missing, it is interpreted as an empty array.
+    /// 'scaling.statsSamples' may also be missing, for compatibility with older
+    /// configurations; it then defaults to 0.
     ///
     /// @param[in] config  Configuration of image write options
     ImageWriteOptions(daf::base::PropertySet const& config);
@@ -547,6 +551,26 @@ public:
         readImageImpl(N, array.getData(), begin.elems, end.elems, increment.elems);
     }
 
+    /**
+     *  Read an array from a FITS image, decompressing tile-compressed images in parallel.
+     *
+     *  When the current HDU is tile-compressed and getImageReadThreads() is greater than one, the
+     *  rows of `array` are divided into bands aligned with the rows of compression tiles.  Each
+     *  band is read by its own thread, through an independent cfitsio handle on a read-only
+     *  memory map of the file, straight into `array`; only the tiles that intersect `array` are
+     *  decompressed.  In all other cases (including files that cannot be memory-mapped, such as
+     *  memory files and gzipped files, files not opened read-only, and builds of cfitsio that are
+     *  not reentrant) this is equivalent to readImage.
+     *
+     *  @param[out]  array    Array to be filled.  Must already be allocated to the desired shape.
+     *  @param[in]   offset   Indices of the first pixel to be read from the image.
+     */
+    template <typename T>
+    void readTiledImage(ndarray::Array<T, 2, 2> const& array, ndarray::Vector<int, 2> const& offset);
+
+    /// Return true if the current HDU is a tile-compressed image.
+    bool isCompressedImage();
+
     /// Create a new binary table extension.
     void createTable();
 
@@ -710,6 +734,46 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits& fitsfile, bool
 void setAllowImageCompression(bool allow);
 bool getAllowImageCompression();
 
+/**
+ * Set the number of threads used to decompress tile-compressed images when reading them.
+ *
+ * The default, 1, decompresses on the calling thread.  See Fits::readTiledImage.
+ */
+void setImageReadThreads(int nThreads);
+int getImageReadThreads();
+
+/**
+ * Set the number of threads used by writeHdus to scale and compress HDUs concurrently.
+ *
+ * The default, 1, writes every HDU directly to its file on the calling thread.
+ */
+void setImageWriteThreads(int nThreads);
+int getImageWriteThreads();
+
+/**
+ *  Call a sequence of HDU-writing functions, concurrently if getImageWriteThreads() allows it.
+ *
+ *  With a single thread, each function is simply called on `fitsfile` in turn.  Otherwise each
+ *  function is given its own in-memory file (which already contains an empty primary HDU, so
+ *  everything it writes is an extension), up to getImageWriteThreads() of them run at once, and the
+ *  HDUs they wrote are then appended to `fitsfile` in the order of `writers`.  The bytes appended are
+ *  exactly those cfitsio produced, so the result is identical to the serial one as long as the
+ *  functions write the same thing whatever file they are given.  That excludes cfitsio's own
+ *  clock-seeded dithering of floating-point pixels (quantizeLevel != 0 with a zero dither seed), which
+ *  differs from one write to the next regardless.
+ *
+ *  Concurrent writes require a reentrant build of cfitsio; otherwise the functions are always called
+ *  serially.
+ *
+ *  @param[in,out] fitsfile  File to write to; must already have a primary HDU.  On return, the last
+ *                           HDU written is the current one.
+ *  @param[in] writers  Functions that each write one or more HDUs to the file they are passed.
+ *
+ *  Exceptions thrown by the functions are rethrown (the first in order, if there are several), and
+ *  nothing is appended to `fitsfile` in that case.
+ */
+void writeHdus(Fits& fitsfile, std::vector<std::function<void(Fits&)>> const& writers);
+
 
 
 /**
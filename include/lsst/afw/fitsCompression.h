@@ -334,6 +334,14 @@ struct ImageScale {
 ///   size to the image standard deviation.
 /// * quantizePad: for the STDEV_POSITIVE and STDEV_NEGATIVE algorithms, specifies
 ///   how many standard deviations to allow on the short side.
+/// * statsSamples: for the STDEV_* algorithms, the number of randomly chosen unmasked
+///   pixels from which to estimate the median and standard deviation, or 0 to use
+///   every unmasked pixel. Sampling avoids copying and partially sorting the whole
+///   image. The sample is drawn with a generator seeded by `seed`, so it is
+///   reproducible. For Gaussian noise, the 1-sigma error in the median is about
+///   1.25 stdev/sqrt(statsSamples), and the fractional error in the standard deviation
+///   (and so in BSCALE and the quantization noise) is about 1.17/sqrt(statsSamples):
+///   0.4% for 10^5 samples.
 /// * bscale, bzero: for the MANUAL algorithm, specifies the BSCALE and BZERO to use.
 ///
 /// Scaling algorithms are:
@@ -371,6 +379,7 @@ public:
     float quantizePad;  ///< Number of stdev to allow on the low/high side (for STDEV_POSITIVE/NEGATIVE)
     double bscale;      ///< Manually specified BSCALE (for MANUAL scaling)
     double bzero;       ///< Manually specified BZERO (for MANUAL scaling)
+    std::size_t statsSamples;  ///< Number of pixels to sample for STDEV_* statistics (0 = all)
 
     /// Default Ctor
     ///
@@ -390,10 +399,11 @@ public:
     /// @param[in] fuzz_  Fuzz the values when quantising floating-point values?
     /// @param[in] bscale_  Manually specified BSCALE (for MANUAL scaling)
     /// @param[in] bzero_  Manually specified BZERO (for MANUAL scaling)
+    /// @param[in] statsSamples_  Number of pixels to sample for STDEV_* statistics, or 0 for all
     ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix_,
                         std::vector<std::string> const& maskPlanes_ = {}, int seed_ = 1,
                         float quantizeLevel_ = 4.0, float quantizePad_ = 5.0, bool fuzz_ = true,
-                        double bscale_ = 1.0, double bzero_ = 0.0);
+                        double bscale_ = 1.0, double bzero_ = 0.0, std::size_t statsSamples_ = 0);
 
     /// Manual scaling Ctor
     ///
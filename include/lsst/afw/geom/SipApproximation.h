@@ -323,6 +323,11 @@ public:
     /**
      *  Obtain a new solution at the given order with the current grid.
      *
+     *  The decompositions of the least-squares problem are cached with the
+     *  grid, so refitting at the same order (e.g. with a different
+     *  svdThreshold) is cheap; after updateGrid or refineGrid they are
+     *  recomputed on the next call.
+     *
      *  @param[in]  order           Polynomial order to fit.
      *  @param[in]  svdThreshold    Fraction of the largest singular value at which to
      *                              declare smaller singular values zero in the least
@@ -361,7 +366,7 @@ private:
     lsst::geom::Box2D _bbox;
     lsst::geom::Extent2D _crpix;
     lsst::geom::LinearTransform _cdInv;
-    std::unique_ptr<Grid const> _grid;
+    std::unique_ptr<Grid> _grid;
     std::unique_ptr<Solution const> _solution;
 };
 
@@ -34,6 +34,7 @@
 #include "lsst/afw/geom/Span.h"
 #include "lsst/geom/Box.h"
 #include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/RunLengthMask.h"
 #include "lsst/afw/table/io/Persistable.h"
 #include "lsst/afw/geom/ellipses/Ellipse.h"
 #include "lsst/afw/geom/ellipses/Quadrupole.h"
@@ -541,6 +542,20 @@ public:
     template <typename T>
     void clearMask(lsst::afw::image::Mask<T> &target, T bitmask) const;
 
+    /** Set a RunLengthMask at pixels defined by the SpanSet
+     *
+     * @param[in, out] target RunLengthMask in which values will be set
+     * @param[in] bitmask The bit pattern to set in the mask
+     */
+    void setMask(image::RunLengthMask &target, image::MaskPixel bitmask) const;
+
+    /** Unset a RunLengthMask at pixels defined by the SpanSet
+     *
+     * @param[in, out] target RunLengthMask in which a bit pattern will be unset
+     * @param[in] bitmask The bit pattern to clear in the mask
+     */
+    void clearMask(image::RunLengthMask &target, image::MaskPixel bitmask) const;
+
     // SpanSet functions
     /** Determine the common points between two SpanSets, and create a new SpanSet
      *
@@ -558,6 +573,13 @@ public:
     template <typename T>
     std::shared_ptr<SpanSet> intersect(image::Mask<T> const &other, T bitmask) const;
 
+    /** Determine the common points between a SpanSet and a RunLengthMask with a given bit pattern
+     *
+     * @param other RunLengthMask with which to calculate intersection
+     * @param bitmask The bit value to consider when intersecting
+     */
+    std::shared_ptr<SpanSet> intersect(image::RunLengthMask const &other, image::MaskPixel bitmask) const;
+
     /** @brief Determine the common points between a SpanSet and the logical inverse of a second SpanSet
      *         and return them in a new SpanSet.
      *
@@ -576,6 +598,14 @@ public:
     template <typename T>
     std::shared_ptr<SpanSet> intersectNot(image::Mask<T> const &other, T bitmask) const;
 
+    /** @brief Determine the common points between a SpanSet and the logical inverse of a RunLengthMask
+     *  for a given bit pattern
+     *
+     * @param other RunLengthMask with which to calculate intersection
+     * @param bitmask The bit value to consider when intersecting
+     */
+    std::shared_ptr<SpanSet> intersectNot(image::RunLengthMask const &other, image::MaskPixel bitmask) const;
+
     /** Create a new SpanSet that contains all points from two SpanSets
      *
      * @param other The SpanSet from which the union will be calculated
@@ -592,6 +622,13 @@ public:
     template <typename T>
     std::shared_ptr<SpanSet> union_(image::Mask<T> const &other, T bitmask) const;
 
+    /** Determine the union between a SpanSet and a RunLengthMask for a given bit pattern
+     *
+     * @param other RunLengthMask with which to calculate the union
+     * @param bitmask The bit value to consider when computing the union
+     */
+    std::shared_ptr<SpanSet> union_(image::RunLengthMask const &other, image::MaskPixel bitmask) const;
+
     // Comparison Operators
 
     /** Compute equality between two SpanSets
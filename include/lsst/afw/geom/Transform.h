@@ -40,6 +40,43 @@ namespace geom {
 
 class SkyWcs;
 
+namespace detail {
+
+/**
+ * The offset and matrix of a linear (affine) ast::Mapping in one direction
+ *
+ * Used by Transform to evaluate linear mappings, such as those made from an lsst::geom::AffineTransform,
+ * without going through AST.
+ */
+class LinearMapping final {
+public:
+    /**
+     * Measure a mapping
+     *
+     * @param[in] mapping  The mapping to measure
+     * @param[in] forward  Measure the forward transformation of mapping (else the inverse)?
+     * @returns the linear mapping equivalent (to rounding) to `mapping`, or null if AST doesn't consider
+     *          `mapping` linear, it lacks the requested transformation, or it doesn't reproduce the
+     *          measured offset and matrix at a test point
+     */
+    static std::shared_ptr<LinearMapping const> measure(ast::Mapping const &mapping, bool forward);
+
+    /// Transform a point
+    std::vector<double> apply(std::vector<double> const &point) const;
+
+    /// Transform an array of points with shape (number of axes, number of points)
+    ndarray::Array<double, 2, 2> apply(ndarray::Array<double, 2, 2> const &points) const;
+
+private:
+    LinearMapping(Eigen::MatrixXd const &matrix, Eigen::VectorXd const &offset)
+            : _matrix(matrix), _offset(offset) {}
+
+    Eigen::MatrixXd _matrix;
+    Eigen::VectorXd _offset;
+};
+
+}  // namespace detail
+
 /**
  * Transform LSST spatial data, such as lsst::geom::Point2D and lsst::geom::SpherePoint, using an AST mapping.
  *
@@ -56,6 +93,10 @@ class SkyWcs;
  *
  * Transforms are always immutable.
  *
+ * If AST reports the simplified mapping as linear (e.g. a combination of shifts, zooms and matrices),
+ * `applyForward` and `applyInverse` evaluate it directly rather than through AST; the results agree with
+ * AST's to rounding error.
+ *
  * @note You gain some safety by constructing a Transform from an ast::FrameSet,
  * since the base and current frames in the FrameSet can be checked against by the appropriate endpoint.
  *
@@ -280,9 +321,14 @@ protected:
     void write(OutputArchiveHandle &handle) const override;
 
 private:
+    // Measure _forwardLinear and _inverseLinear from _mapping
+    void _initializeLinear();
+
     FromEndpoint _fromEndpoint;
     std::shared_ptr<const ast::Mapping> _mapping;
     ToEndpoint _toEndpoint;
+    std::shared_ptr<detail::LinearMapping const> _forwardLinear;  // null unless _mapping is linear
+    std::shared_ptr<detail::LinearMapping const> _inverseLinear;  // null unless _mapping is linear
 };
 
 /**
@@ -30,6 +30,8 @@
 
 #include <memory>
 
+#include "ndarray.h"
+
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
 #include "lsst/geom/Box.h"
@@ -143,6 +145,16 @@ public:
     /// Returns whether the polygon contains the point
     bool contains(Point const& point) const;
 
+    /// Returns whether the polygon contains each of a set of points
+    ///
+    /// The edges of the polygon are indexed by height once, so this is much
+    /// faster than calling contains(Point) for each point.  Points lying
+    /// exactly on the boundary may be reported as either inside or outside.
+    ///
+    /// @throws lsst::pex::exceptions::LengthError if `x` and `y` have different sizes.
+    ndarray::Array<bool, 1, 1> contains(ndarray::Array<double const, 1> const& x,
+                                        ndarray::Array<double const, 1> const& y) const;
+
     //@{
     /// Returns whether the polygons overlap each other
     ///
@@ -243,6 +255,9 @@ public:
     /// on the border receive a value equal to the fraction of the pixel
     /// within the polygon.
     ///
+    /// The fractions are computed analytically, one pixel row at a time, so
+    /// the cost is dominated by the number of pixels written.
+    ///
     /// Note that the center of the lower-left pixel is 0,0.
     std::shared_ptr<afw::image::Image<float>> createImage(lsst::geom::Box2I const& bbox) const;
     std::shared_ptr<afw::image::Image<float>> createImage(lsst::geom::Extent2I const& extent) const {
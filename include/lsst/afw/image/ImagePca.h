@@ -34,6 +34,8 @@
 
 #include <memory>
 
+#include "Eigen/Core"
+
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/image/MaskedImage.h"
 
@@ -78,7 +80,30 @@ public:
      * Return the mean of the images in ImagePca's list
      */
     std::shared_ptr<ImageT> getMean() const;
+
+    /**
+     * Calculate the PCA decomposition of the images
+     *
+     * The images' pixels are copied into a matrix (one column per image) and their inner products are
+     * computed with a single blocked matrix product.  In incremental mode (see setIncremental) the matrix
+     * and inner products are kept, and a later call only computes the inner products involving images
+     * added since.
+     */
     virtual void analyze();
+
+    /**
+     * Should analyze() keep its work for use by later calls?
+     *
+     * This allows images to be added a few at a time, recomputing the decomposition after each batch at a
+     * cost proportional to the number of new images rather than the square of the total.  The images must
+     * not be modified while in incremental mode, other than by updateBadPixels (which discards the saved
+     * work); it costs memory equal to the pixels of all the images, in double precision.
+     *
+     * @param incremental Keep the pixels and inner products between calls to analyze()?
+     */
+    void setIncremental(bool incremental);
+    /// Does analyze() keep its work for use by later calls?
+    bool isIncremental() const { return _incremental; }
     /**
      * Update the bad pixels (i.e. those for which (value & mask) != 0) based on the current PCA
      * decomposition;
@@ -110,6 +135,10 @@ private:
 
     std::vector<double> _eigenValues;  // Eigen values
     ImageList _eigenImages;            // Eigen images
+
+    bool _incremental;               // keep _pixels and _innerProducts between calls to analyze()?
+    Eigen::MatrixXd _pixels;         // image planes of the images analyzed so far, one per column
+    Eigen::MatrixXd _innerProducts;  // inner products of the columns of _pixels, ignoring non-finite values
 };
 
 /**
@@ -350,6 +350,18 @@ public:
     MaskedImage<float> calibrateImage(MaskedImage<float> const &maskedImage,
                                       bool includeScaleUncertainty = true) const;
 
+    /**
+     * Flux calibrate an image in place, converting its pixel values to nJy.
+     *
+     * This is equivalent to calibrateImage, but avoids the copy and updates
+     * the image and variance planes in a single pass.  The mask is not
+     * modified.
+     *
+     * @param maskedImage The masked image to calibrate.
+     * @param includeScaleUncertainty Include the uncertainty on the calibration in the resulting variance?
+     */
+    void calibrateImageInPlace(MaskedImage<float> &maskedImage, bool includeScaleUncertainty = true) const;
+
     /**
      * Return a flux calibrated catalog, with new `_flux`, `_fluxErr`, `_mag`, and `_magErr` fields.
      *
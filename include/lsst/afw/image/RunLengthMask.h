@@ -0,0 +1,157 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_RUNLENGTHMASK_H
+#define LSST_AFW_IMAGE_RUNLENGTHMASK_H
+
+#include <array>
+#include <memory>
+
+#include "lsst/geom/Box.h"
+#include "lsst/geom/Point.h"
+#include "lsst/afw/image/LsstImageTypes.h"
+#include "lsst/afw/image/Mask.h"
+
+namespace lsst {
+namespace afw {
+namespace geom {
+class SpanSet;
+}  // namespace geom
+namespace image {
+
+/**
+ * A compressed in-memory representation of a Mask.
+ *
+ * Each mask plane is stored separately as a run-length encoded SpanSet (in
+ * the parent coordinate system), and planes with no pixels set take no
+ * space.  Because most planes of a typical mask are nearly empty, this is
+ * usually much smaller than a Mask, and bitwise operations and queries
+ * scale with the number of runs rather than the number of pixels.
+ *
+ * The SpanSets holding the planes are immutable and shared between copies,
+ * so copying a RunLengthMask is cheap.
+ *
+ * Use RunLengthMask(Mask const &) and toMask() to convert to and from a
+ * regular Mask, and SpanSet::setMask, SpanSet::clearMask and
+ * SpanSet::intersect to combine it with SpanSets.
+ */
+class RunLengthMask final {
+public:
+    using MaskPlaneDict = Mask<MaskPixel>::MaskPlaneDict;
+
+    /**
+     * Construct an empty mask.
+     *
+     * @param[in] bbox  Bounding box of the mask, in parent coordinates.
+     * @param[in] planeDefs  Mask plane definitions; if empty, the current
+     *     default mask plane dictionary is used (as for Mask).
+     */
+    explicit RunLengthMask(lsst::geom::Box2I const &bbox, MaskPlaneDict const &planeDefs = MaskPlaneDict());
+
+    /// Compress a Mask, keeping its bounding box and mask plane definitions.
+    explicit RunLengthMask(Mask<MaskPixel> const &mask);
+
+    RunLengthMask(RunLengthMask const &) = default;
+    RunLengthMask(RunLengthMask &&) = default;
+    RunLengthMask &operator=(RunLengthMask const &) = default;
+    RunLengthMask &operator=(RunLengthMask &&) = default;
+    ~RunLengthMask() = default;
+
+    /// Return the bounding box of the mask, in parent coordinates.
+    lsst::geom::Box2I getBBox() const { return _bbox; }
+
+    /// Return the mask plane definitions.
+    MaskPlaneDict const &getMaskPlaneDict() const { return _planeDict; }
+
+    /// Return the bit mask of the named plane in this mask's plane definitions.
+    MaskPixel getPlaneBitMask(std::string const &name) const;
+
+    /// Expand into a regular Mask with the same bounding box and mask plane definitions.
+    Mask<MaskPixel> toMask() const;
+
+    /// Return the value of the mask at a point, or zero if it is outside the bounding box.
+    MaskPixel get(lsst::geom::Point2I const &point) const;
+
+    /// Return true if any pixel has any of the given bits set.
+    bool any(MaskPixel bitmask) const;
+
+    /// Return the bits that are set in at least one pixel.
+    MaskPixel getUsedBits() const;
+
+    /// Return the pixels that have any of the given bits set.
+    std::shared_ptr<geom::SpanSet> getSpanSet(MaskPixel bitmask) const;
+
+    /// Return the total number of runs stored over all planes.
+    std::size_t getNumSpans() const;
+
+    /**
+     * Set the given bits in all pixels of a SpanSet.
+     *
+     * @throws lsst::pex::exceptions::OutOfRangeError if the SpanSet is not
+     *     contained by the bounding box of the mask.
+     */
+    void setSpanSet(geom::SpanSet const &spans, MaskPixel bitmask);
+
+    /// Clear the given bits in all pixels of a SpanSet.
+    void clearSpanSet(geom::SpanSet const &spans, MaskPixel bitmask);
+
+    //@{
+    /**
+     * Combine with another mask plane by plane.
+     *
+     * @throws lsst::pex::exceptions::RuntimeError if the masks have different
+     *     mask plane definitions.
+     * @throws lsst::pex::exceptions::LengthError if the masks have different
+     *     bounding boxes.
+     */
+    RunLengthMask &operator|=(RunLengthMask const &rhs);
+    RunLengthMask &operator&=(RunLengthMask const &rhs);
+    //@}
+
+    /// Set the given bits in all pixels.
+    RunLengthMask &operator|=(MaskPixel rhs);
+
+    /// Clear all bits other than the given ones in all pixels.
+    RunLengthMask &operator&=(MaskPixel rhs);
+
+    /// Return true if the masks have the same bounding box, plane definitions and pixels.
+    bool operator==(RunLengthMask const &other) const;
+    bool operator!=(RunLengthMask const &other) const { return !(*this == other); }
+
+private:
+    static constexpr int N_PLANES = 8 * sizeof(MaskPixel);
+
+    void _checkCompatible(RunLengthMask const &other) const;
+
+    lsst::geom::Box2I _bbox;
+    MaskPlaneDict _planeDict;
+    // One SpanSet per bit; null for bits that are set in no pixels.
+    std::array<std::shared_ptr<geom::SpanSet const>, N_PLANES> _planes;
+};
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_IMAGE_RUNLENGTHMASK_H
@@ -0,0 +1,139 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_SHAREDMEMORY_H
+#define LSST_AFW_IMAGE_SHAREDMEMORY_H
+
+#include <string>
+
+#include "lsst/geom/Box.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/MaskedImage.h"
+
+namespace lsst { namespace afw { namespace image {
+
+/*
+ * Images whose pixels live in memory that can be mapped by several processes.
+ *
+ * The pixels are allocated in a named block that is backed either by a POSIX
+ * shared memory object or by a regular file:
+ *
+ *  - a name of the form "/identifier" (a single leading slash and no other
+ *    slashes) refers to a POSIX shared memory object (see shm_open(3));
+ *  - any other name is interpreted as the path of a file.
+ *
+ * The block starts with a small header recording the bounding box and pixel
+ * types of the planes it holds, so a process that attaches to it needs only
+ * the name.  Images returned by these functions are ordinary Image, Mask and
+ * MaskedImage objects whose ndarray Manager keeps the mapping alive; the
+ * mapping is released when the last image (or view, or NumPy array) that
+ * refers to it is destroyed.
+ *
+ * Mask bits are interpreted using the default mask plane dictionary of the
+ * attaching process, exactly as for a Mask constructed from an array, so all
+ * processes must define their mask planes consistently.
+ *
+ * The name of a block persists until unlinkSharedMemory is called (or, for
+ * POSIX shared memory, until the system is rebooted); unlinking while other
+ * processes still have the block attached is safe.
+ *
+ * To share an Exposure, share its MaskedImage this way and transfer the much
+ * smaller ExposureInfo by other means (e.g. pickling).
+ */
+
+/**
+ * Create a new, zero-filled Image in shared memory.
+ *
+ * @param name  Name of the shared memory object or file to create.
+ * @param bbox  Bounding box of the new image.
+ *
+ * @throws lsst::pex::exceptions::IoError if the block could not be created
+ *     or mapped, including if `name` already exists.
+ */
+template <typename PixelT>
+Image<PixelT> makeSharedImage(std::string const& name, lsst::geom::Box2I const& bbox);
+
+/**
+ * Attach to an Image created by makeSharedImage, possibly in another process.
+ *
+ * @param name  Name of the shared memory object or file.
+ * @param readOnly  If true, the block is mapped copy-on-write: pixels are
+ *     shared until the attaching process modifies them, and modifications
+ *     are never visible to other processes.  If false, the mapping is shared
+ *     and writes are seen by every process attached to the block.
+ *
+ * @throws lsst::pex::exceptions::IoError if the block could not be opened or
+ *     mapped.
+ * @throws lsst::pex::exceptions::TypeError if the block does not hold an
+ *     Image of the requested pixel type.
+ */
+template <typename PixelT>
+Image<PixelT> attachSharedImage(std::string const& name, bool readOnly = true);
+
+/**
+ * Create a new, zero-filled Mask in shared memory.
+ *
+ * @copydetails makeSharedImage
+ */
+Mask<MaskPixel> makeSharedMask(std::string const& name, lsst::geom::Box2I const& bbox);
+
+/**
+ * Attach to a Mask created by makeSharedMask, possibly in another process.
+ *
+ * @copydetails attachSharedImage
+ */
+Mask<MaskPixel> attachSharedMask(std::string const& name, bool readOnly = true);
+
+/**
+ * Create a new, zero-filled MaskedImage whose three planes share a single
+ * block of shared memory.
+ *
+ * @copydetails makeSharedImage
+ */
+template <typename ImagePixelT>
+MaskedImage<ImagePixelT> makeSharedMaskedImage(std::string const& name, lsst::geom::Box2I const& bbox);
+
+/**
+ * Attach to a MaskedImage created by makeSharedMaskedImage, possibly in
+ * another process.
+ *
+ * @copydetails attachSharedImage
+ */
+template <typename ImagePixelT>
+MaskedImage<ImagePixelT> attachSharedMaskedImage(std::string const& name, bool readOnly = true);
+
+/**
+ * Remove the name of a shared memory block.
+ *
+ * Images that are already attached to the block remain valid; the memory is
+ * returned to the system when the last of them is destroyed.
+ *
+ * @throws lsst::pex::exceptions::IoError if the name could not be removed.
+ */
+void unlinkSharedMemory(std::string const& name);
+
+}}}  // namespace lsst::afw::image
+
+#endif  // !LSST_AFW_IMAGE_SHAREDMEMORY_H
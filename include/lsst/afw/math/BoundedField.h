@@ -87,6 +87,24 @@ public:
     virtual ndarray::Array<double, 1, 1> evaluate(ndarray::Array<double const, 1> const& x,
                                                   ndarray::Array<double const, 1> const& y) const;
 
+    /**
+     *  Evaluate the field on a rectangular grid of points
+     *
+     *  @param[in]  x         x coordinates of the grid columns
+     *  @param[in]  y         y coordinates of the grid rows
+     *  @returns an array with shape (y.size(), x.size()), with element [i, j] equal to the
+     *           field evaluated at (x[j], y[i])
+     *
+     *  This is used by fillImage(), addToImage(), multiplyImage() and divideImage().  The default
+     *  implementation calls the multi-point evaluate() once per row; subclasses that can share
+     *  work between rows or columns should override it.
+     *
+     *  There is no bounds-checking on the given positions; this is the responsibility
+     *  of the user, who can almost always do it more efficiently.
+     */
+    virtual ndarray::Array<double, 2, 2> evaluateGrid(ndarray::Array<double const, 1> const& x,
+                                                      ndarray::Array<double const, 1> const& y) const;
+
     /**
      * Compute the integral of this function over its bounding-box.
      *
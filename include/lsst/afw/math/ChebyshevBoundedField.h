@@ -195,6 +195,15 @@ public:
 
     using BoundedField::evaluate;
 
+    /**
+     *  @copydoc BoundedField::evaluateGrid
+     *
+     *  The Chebyshev polynomials are evaluated once for each column and each row, so the
+     *  field on the grid is the matrix product T(y) C T(x)^T.
+     */
+    ndarray::Array<double, 2, 2> evaluateGrid(ndarray::Array<double const, 1> const& x,
+                                              ndarray::Array<double const, 1> const& y) const override;
+
     /// @copydoc BoundedField::integrate
     double integrate() const override;
 
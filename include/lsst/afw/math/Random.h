@@ -29,6 +29,7 @@
 #ifndef LSST_AFW_MATH_RANDOM_H
 #define LSST_AFW_MATH_RANDOM_H
 
+#include <cstdint>
 #include <memory>
 
 #include "gsl/gsl_rng.h"
@@ -350,6 +351,96 @@ void randomChisqImage(ImageT *image, Random &rand, double const nu);
  */
 template <typename ImageT>
 void randomPoissonImage(ImageT *image, Random &rand, double const mu);
+
+/*
+ * Create Images containing counter-based random numbers
+ *
+ * Unlike the functions above, these don't use a Random.  The random numbers for each pixel are a pure
+ * function of the seed and the pixel's position in the parent image (they are generated by the
+ * Philox4x32-10 counter-based generator), so the result doesn't depend on the number of threads used, and
+ * filling a subimage gives exactly the pixels that filling the whole image would.  The algorithms differ
+ * from GSL's, so the values are not those given by a Random.
+ */
+/**
+ * Set image to counter-based random numbers uniformly distributed in the range [0, 1)
+ *
+ * @param[out] image The image to set
+ * @param[in] seed seed of the random numbers
+ * @param[in] nThreads number of threads to use
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if nThreads is not positive
+ */
+template <typename ImageT>
+void randomUniformImage(ImageT *image, std::uint64_t seed, int nThreads = 1);
+
+/**
+ * Set image to counter-based random numbers uniformly distributed in the range (0, 1)
+ *
+ * @copydetails randomUniformImage(ImageT*, std::uint64_t, int)
+ */
+template <typename ImageT>
+void randomUniformPosImage(ImageT *image, std::uint64_t seed, int nThreads = 1);
+
+/**
+ * Set image to counter-based random integers uniformly distributed in the range 0 ... n - 1
+ *
+ * @param[out] image The image to set
+ * @param[in] seed seed of the random numbers
+ * @param[in] n (exclusive) upper limit for random variates
+ * @param[in] nThreads number of threads to use
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if n is zero or nThreads is not positive
+ */
+template <typename ImageT>
+void randomUniformIntImage(ImageT *image, std::uint64_t seed, unsigned long n, int nThreads = 1);
+
+/**
+ * Set image to counter-based random numbers uniformly distributed in the range [a, b)
+ *
+ * @param[out] image The image to set
+ * @param[in] seed seed of the random numbers
+ * @param[in] a (inclusive) lower limit for random variates
+ * @param[in] b (exclusive) upper limit for random variates
+ * @param[in] nThreads number of threads to use
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if nThreads is not positive
+ */
+template <typename ImageT>
+void randomFlatImage(ImageT *image, std::uint64_t seed, double const a, double const b, int nThreads = 1);
+
+/**
+ * Set image to counter-based random numbers with a gaussian N(0, 1) distribution
+ *
+ * @copydetails randomUniformImage(ImageT*, std::uint64_t, int)
+ */
+template <typename ImageT>
+void randomGaussianImage(ImageT *image, std::uint64_t seed, int nThreads = 1);
+
+/**
+ * Set image to counter-based random numbers with a chi^2_{nu} distribution
+ *
+ * @param[out] image The image to set
+ * @param[in] seed seed of the random numbers
+ * @param[in] nu number of degrees of freedom
+ * @param[in] nThreads number of threads to use
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if nu or nThreads is not positive
+ */
+template <typename ImageT>
+void randomChisqImage(ImageT *image, std::uint64_t seed, double const nu, int nThreads = 1);
+
+/**
+ * Set image to counter-based random numbers with a Poisson distribution with mean mu (n.b. not per-pixel)
+ *
+ * @param[out] image The image to set
+ * @param[in] seed seed of the random numbers
+ * @param[in] mu mean of distribution
+ * @param[in] nThreads number of threads to use
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if mu is negative or nThreads is not positive
+ */
+template <typename ImageT>
+void randomPoissonImage(ImageT *image, std::uint64_t seed, double const mu, int nThreads = 1);
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
@@ -108,6 +108,7 @@ public:
               _isNanSafe(isNanSafe),
               _useWeights(useWeights),
               _calcErrorFromInputVariance(false),
+              _quantileTolerance(0.0),
               _maskPropagationThresholds() {
         try {
             _noGoodPixelsMask = lsst::afw::image::Mask<>::getPlaneBitMask("NO_DATA");
@@ -137,6 +138,7 @@ public:
     bool getWeighted() const noexcept { return _useWeights == WEIGHTS_TRUE ? true : false; }
     bool getWeightedIsSet() const noexcept { return _useWeights != WEIGHTS_NONE ? true : false; }
     bool getCalcErrorFromInputVariance() const noexcept { return _calcErrorFromInputVariance; }
+    double getQuantileTolerance() const noexcept { return _quantileTolerance; }
 
     void setNumSigmaClip(double numSigmaClip) {
         if (!(numSigmaClip > 0)) {
@@ -159,6 +161,24 @@ public:
     void setCalcErrorFromInputVariance(bool calcErrorFromInputVariance) noexcept {
         _calcErrorFromInputVariance = calcErrorFromInputVariance;
     }
+    /**
+     * Estimate MEDIAN and IQRANGE (and the first clip of MEANCLIP etc.) from histograms.
+     *
+     * If `tolerance` is positive, the median and quartiles of floating-point images are found by
+     * repeatedly histogramming the pixels near them, without copying the image, until each is known
+     * to within `tolerance` times the standard deviation implied by the interquartile range.  That
+     * takes two passes over the pixels for roughly Gaussian data and tolerances down to about 1e-6,
+     * and a few more if there are strong outliers.  Integer images, and data for which the estimate
+     * cannot be made (e.g. a zero standard deviation), still use the exact calculation, as does a
+     * tolerance of zero (the default).
+     */
+    void setQuantileTolerance(double tolerance) {
+        if (!(tolerance >= 0)) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "quantileTolerance must not be negative.");
+        }
+        _quantileTolerance = tolerance;
+    }
 
 private:
     friend class Statistics;
@@ -170,6 +190,7 @@ private:
     bool _isNanSafe;                   // Check for NaNs & Infs before running (slower)
     WeightsBoolean _useWeights;        // Calculate weighted statistics (enum because of 3-valued logic)
     bool _calcErrorFromInputVariance;  // Calculate errors from the input variances, if available
+    double _quantileTolerance;         // Precision of histogram quantiles, in stdev; 0 for exact quantiles
     std::vector<double> _maskPropagationThresholds;  // Thresholds for when to propagate mask bits,
                                                      // treated like a dict (unset bits are set to 1.0)
 };
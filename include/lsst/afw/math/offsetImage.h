@@ -23,6 +23,9 @@
 #if !defined(LSST_AFW_MATH_OFFSETIMAGE_H)
 #define LSST_AFW_MATH_OFFSETIMAGE_H 1
 
+#include <memory>
+#include <vector>
+
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Statistics.h"
 
@@ -69,6 +72,18 @@ std::shared_ptr<ImageT> rotateImageBy90(ImageT const& image, int nQuarter);
  */
 template <typename ImageT>
 std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipTB);
+
+/**
+ * Flip an image left--right and/or top--bottom in place
+ *
+ * The pixels are modified where they are, so this is seen by all images that share them.
+ *
+ * @param image The %image to flip
+ * @param flipLR Flip left <--> right?
+ * @param flipTB Flip top <--> bottom?
+ */
+template <typename ImageT>
+void flipImageInPlace(ImageT& image, bool flipLR, bool flipTB);
 /**
  * @param inImage The %image to bin
  * @param binX Output pixels are binX*binY input pixels
@@ -86,6 +101,21 @@ std::shared_ptr<ImageT> binImage(ImageT const& inImage, int const binX, int cons
 template <typename ImageT>
 std::shared_ptr<ImageT> binImage(ImageT const& inImage, int const binsize,
                                  lsst::afw::math::Property const flags = lsst::afw::math::MEAN);
+/**
+ * Bin an image by 2, 4, 8, ... 2^nLevels
+ *
+ * Each level is binned from the one before, keeping the intermediate sums in double precision, so the
+ * result equals (up to floating-point rounding) calling binImage once per binning factor, but only costs
+ * about as much as the first of those calls.
+ *
+ * @param inImage The %image to bin
+ * @param nLevels Number of binned images to make
+ * @returns the binned images, the i-th (starting at 0) binned by 2^(i + 1) in both x and y
+ *
+ * @throws lsst::pex::exceptions::DomainError if nLevels is not positive
+ */
+template <typename ImageT>
+std::vector<std::shared_ptr<ImageT>> binImagePyramid(ImageT const& inImage, int const nLevels);
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
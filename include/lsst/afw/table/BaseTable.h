@@ -227,6 +227,17 @@ private:
     friend class BaseRecord;
     friend class io::FitsWriter;
     friend class AliasMap;
+    template <typename RecordT>
+    friend class CatalogT;
+
+    /*
+     *  Move the field data of the given records into a single new memory block, contiguous in the given
+     *  order (used to implement CatalogT::makeContiguous).
+     *
+     *  Records must have the same schema as this table and may not appear more than once.  The record
+     *  objects themselves are not replaced.
+     */
+    void _makeContiguous(std::vector<BaseRecord*> const& records);
 
     // Obtain raw data pointers and their managing objects for a new record.
     detail::RecordData _makeNewRecordData();
@@ -2,7 +2,10 @@
 #ifndef AFW_TABLE_Catalog_h_INCLUDED
 #define AFW_TABLE_Catalog_h_INCLUDED
 
+#include <algorithm>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "boost/iterator/iterator_adaptor.hpp"
@@ -63,6 +66,9 @@ private:
     typename BaseT::value_type::element_type& dereference() const { return **this->base(); }
 };
 
+template <typename RecordT, typename T>
+class CatalogIndex;
+
 /**
  *  A custom container class for records, based on std::vector.
  *
@@ -392,6 +398,30 @@ public:
     /// Return true if all records are contiguous.
     bool isContiguous() const { return ColumnView::isRangeContiguous(_table, begin(), end()); }
 
+    /**
+     *  Move the data of all records into a single block of memory, in catalog order, so that
+     *  getColumnView will succeed.
+     *
+     *  This is a no-op if the catalog is already contiguous.  Otherwise it copies each record's field
+     *  data once; this is typically much cheaper than a deep copy after sorts, inserts or concatenations,
+     *  as records are not reconstructed.  The record objects are not replaced, so other catalogs and
+     *  shared_ptrs holding them see the moved data, but references, arrays and ColumnViews obtained
+     *  from the records before this call no longer refer to their data.
+     *
+     *  @throws pex::exceptions::InvalidParameterError if a record appears more than once in the catalog,
+     *      or a record's schema differs from the catalog's.
+     */
+    void makeContiguous() {
+        if (isContiguous()) return;
+        std::vector<BaseRecord*> records;
+        records.reserve(_internal.size());
+        for (auto const& record : _internal) {
+            // Moving a record's data does not change its values, so this is safe for const records.
+            records.push_back(const_cast<BaseRecord*>(static_cast<BaseRecord const*>(record.get())));
+        }
+        _table->_makeContiguous(records);
+    }
+
     //@{
     /**
      *  Iterator access.
@@ -590,7 +620,13 @@ public:
     template <typename Compare>
     bool isSorted(Compare cmp) const;
 
-    /// Sort the catalog in-place by the field with the given key.
+    /**
+     *  Sort the catalog in-place by the field with the given key.
+     *
+     *  The sort is stable.  Field values are extracted from each record once and sorted with their
+     *  positions, so records are not dereferenced in comparisons.  Records with NaN values are placed
+     *  after all others.
+     */
     template <typename T>
     void sort(Key<T> const& key);
 
@@ -626,6 +662,19 @@ public:
     const_iterator find(typename Field<T>::Value const& value, Key<T> const& key) const;
     //@}
 
+    /**
+     *  Return a hash index from the values of the given field to the records of the catalog.
+     *
+     *  The index finds records by value (typically an ID) in constant time whether or not the
+     *  catalog is sorted.  It is a snapshot, and is not updated when the catalog changes.
+     *
+     *  @see CatalogIndex
+     */
+    template <typename T>
+    CatalogIndex<RecordT, T> makeIndex(Key<T> const& key) const {
+        return CatalogIndex<RecordT, T>(*this, key);
+    }
+
     //@{
     /**
      *  Performed binary searches on sorted fields.
@@ -692,6 +741,46 @@ private:
     Internal _internal;
 };
 
+/**
+ *  A hash table from the values of one field to the records of a catalog that hold them.
+ *
+ *  This is intended for ID-like fields, so records can be looked up in constant time in catalogs that
+ *  are not sorted by that field.  The index holds shallow copies of the records, and it is not updated
+ *  if records are added to or removed from the catalog or their values of the field change.
+ *
+ *  @tparam RecordT  Record type of the catalog.
+ *  @tparam T  Type of the field; its values must be hashable (e.g. integers or strings).
+ */
+template <typename RecordT, typename T>
+class CatalogIndex final {
+public:
+    using Value = typename Field<T>::Value;
+
+    /// Index all records in a catalog.  If several records share a value, the first one is indexed.
+    CatalogIndex(CatalogT<RecordT> const& catalog, Key<T> const& key) : _key(key) {
+        _map.reserve(catalog.size());
+        for (auto iter = catalog.begin(); iter != catalog.end(); ++iter) {
+            _map.emplace(iter->get(key), std::shared_ptr<RecordT>(iter));
+        }
+    }
+
+    /// Return the record with the given value, or a null pointer if there is none.
+    std::shared_ptr<RecordT> find(Value const& value) const {
+        auto iter = _map.find(value);
+        return (iter == _map.end()) ? std::shared_ptr<RecordT>() : iter->second;
+    }
+
+    /// Return the number of distinct values indexed.
+    std::size_t size() const { return _map.size(); }
+
+    /// Return the key of the indexed field.
+    Key<T> const& getKey() const { return _key; }
+
+private:
+    Key<T> _key;
+    std::unordered_map<Value, std::shared_ptr<RecordT>> _map;
+};
+
 namespace detail {
 
 template <typename RecordT, typename T>
@@ -754,8 +843,30 @@ bool CatalogT<RecordT>::isSorted(Key<T> const& key) const {
 template <typename RecordT>
 template <typename T>
 void CatalogT<RecordT>::sort(Key<T> const& key) {
-    detail::KeyComparisonFunctor<RecordT, T> f = {key};
-    return sort(f);
+    // Sort (value, position) pairs; positions are unique, so breaking ties with them makes an unstable
+    // sort stable.  NaNs (the only values that don't compare equal to themselves) sort last.
+    using Value = typename Field<T>::Value;
+    std::vector<std::pair<Value, size_type>> keyed;
+    keyed.reserve(_internal.size());
+    for (size_type i = 0; i < _internal.size(); ++i) {
+        keyed.emplace_back(_internal[i]->get(key), i);
+    }
+    std::sort(keyed.begin(), keyed.end(), [](auto const& a, auto const& b) {
+        bool const aIsNan = !(a.first == a.first);
+        bool const bIsNan = !(b.first == b.first);
+        if (aIsNan != bIsNan) return bIsNan;
+        if (!aIsNan) {
+            if (a.first < b.first) return true;
+            if (b.first < a.first) return false;
+        }
+        return a.second < b.second;
+    });
+    Internal sorted;
+    sorted.reserve(_internal.size());
+    for (auto const& item : keyed) {
+        sorted.push_back(std::move(_internal[item.second]));
+    }
+    _internal.swap(sorted);
 }
 
 template <typename RecordT>
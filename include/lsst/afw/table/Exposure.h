@@ -23,6 +23,9 @@
 #ifndef AFW_TABLE_Exposure_h_INCLUDED
 #define AFW_TABLE_Exposure_h_INCLUDED
 
+#include <memory>
+#include <vector>
+
 #include "lsst/geom/Box.h"
 #include "lsst/geom/SpherePoint.h"
 #include "lsst/afw/fitsDefaults.h"
@@ -481,6 +484,17 @@ public:
     ExposureCatalogT subsetContaining(lsst::geom::Point2D const& point, geom::SkyWcs const& wcs,
                                       bool includeValidPolygon = false) const;
 
+    /**
+     *  Return shallow subsets of the catalog with only those records that contain each of the given points.
+     *
+     *  This builds an ExposureSkyIndexT over the catalog and queries it for each point, so it is much
+     *  faster than calling the single-point overload repeatedly on large catalogs.
+     *
+     *  @see ExposureSkyIndexT
+     */
+    std::vector<ExposureCatalogT> subsetContaining(std::vector<lsst::geom::SpherePoint> const& coords,
+                                                   bool includeValidPolygon = false) const;
+
 protected:
     explicit ExposureCatalogT(Base const& other) : Base(other) {}
 };
@@ -489,6 +503,58 @@ using ExposureColumnView = ColumnViewT<ExposureRecord>;
 using ExposureCatalog = ExposureCatalogT<ExposureRecord>;
 using ConstExposureCatalog = ExposureCatalogT<const ExposureRecord>;
 
+/**
+ *  A spatial index over an ExposureCatalog, for finding the records that contain points on the sky.
+ *
+ *  Each record is given a bounding circle on the sky by mapping points along the edges of its bounding
+ *  box through its Wcs, and the circles are bucketed into the cells of a grid of declination bands.
+ *  A query runs ExposureRecord::contains only on the records whose circles contain the point, so the
+ *  results are the same as those of ExposureCatalogT::subsetContaining.  Records that cannot be bounded
+ *  (e.g. those without a Wcs) are always tested.
+ *
+ *  The index holds a shallow copy of the catalog; it is not updated if the catalog is modified, or if
+ *  the bounding boxes or Wcss of its records are changed.
+ */
+template <typename RecordT>
+class ExposureSkyIndexT final {
+public:
+    using Catalog = ExposureCatalogT<RecordT>;
+
+    /// Build an index over all records in a catalog.
+    explicit ExposureSkyIndexT(Catalog const& catalog);
+
+    ExposureSkyIndexT(ExposureSkyIndexT const&);
+    ExposureSkyIndexT(ExposureSkyIndexT&&);
+    ExposureSkyIndexT& operator=(ExposureSkyIndexT const&);
+    ExposureSkyIndexT& operator=(ExposureSkyIndexT&&);
+    ~ExposureSkyIndexT();
+
+    /// Return the catalog the index was built from.
+    Catalog const& getCatalog() const;
+
+    /**
+     *  Return a shallow subset of the catalog with only those records that contain the given point.
+     *
+     *  @see ExposureCatalogT::subsetContaining
+     */
+    Catalog subsetContaining(lsst::geom::SpherePoint const& coord, bool includeValidPolygon = false) const;
+
+    /**
+     *  Return shallow subsets of the catalog with only those records that contain each of the given points.
+     *
+     *  @see ExposureCatalogT::subsetContaining
+     */
+    std::vector<Catalog> subsetContaining(std::vector<lsst::geom::SpherePoint> const& coords,
+                                          bool includeValidPolygon = false) const;
+
+private:
+    class Impl;
+
+    std::shared_ptr<Impl const> _impl;
+};
+
+using ExposureSkyIndex = ExposureSkyIndexT<ExposureRecord>;
+
 inline RecordId ExposureRecord::getId() const { return get(ExposureTable::getIdKey()); }
 inline void ExposureRecord::setId(RecordId id) { set(ExposureTable::getIdKey(), id); }
 }  // namespace table
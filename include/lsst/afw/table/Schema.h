@@ -94,6 +94,18 @@ public:
     template <typename T>
     SchemaItem<T> find(std::string const& name) const;
 
+    /**
+     *  Find the Keys of many fields of the same type by name.
+     *
+     *  This resolves aliases and looks up each name once, so code that accesses the same fields of
+     *  many records can do all of its string lookups up front and then use only the returned Keys.
+     *
+     *  @throws pex::exceptions::NotFoundError if any name is not in the Schema.
+     *  @throws pex::exceptions::TypeError if any field does not have type `T`.
+     */
+    template <typename T>
+    std::vector<Key<T>> findKeys(std::vector<std::string> const& names) const;
+
     /**
      *  Find a SchemaItem in the Schema by key.
      *
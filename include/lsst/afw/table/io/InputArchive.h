@@ -73,6 +73,17 @@ public:
      */
     static InputArchive readFits(fits::Fits& fitsfile);
 
+    /**
+     *  Read an object from an already open FITS object, deferring reading data catalogs until needed.
+     *
+     *  Only the index catalog is read immediately; each data catalog is read the first time an object
+     *  stored in it is loaded.  The HDU of `fitsfile` is restored after each such read.
+     *
+     *  @param[in]  fitsfile     FITS object to read from, already positioned at the desired HDU.
+     *                           It must remain open for the lifetime of the archive.
+     */
+    static InputArchive readFitsLazy(fits::Fits& fitsfile);
+
 private:
     class Impl;
 
@@ -243,6 +243,7 @@ PyCatalog<Record> declareCatalog(utils::python::WrapperCollection &wrappers, std
                     return self.get(utils::python::cppIndex(self.size(), i));
                 });
                 cls.def("isContiguous", &Catalog::isContiguous);
+                cls.def("_makeContiguous", &Catalog::makeContiguous);
                 cls.def("writeFits",
                         (void (Catalog::*)(std::string const &, std::string const &, int) const) &
                                 Catalog::writeFits,
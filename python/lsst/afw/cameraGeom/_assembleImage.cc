@@ -0,0 +1,76 @@
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+
+#include <pybind11/pybind11.h>
+#include <lsst/utils/python.h>
+
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/image/Exposure.h"
+#include "lsst/afw/cameraGeom/assembleImage.h"
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+namespace {
+
+template <typename ImageT>
+void declareAssemble(lsst::utils::python::WrapperCollection &wrappers) {
+    wrappers.wrap([](auto &mod) {
+        mod.def("assembleAmplifier", &assembleAmplifier<ImageT>, "destImage"_a, "rawImage"_a, "amplifier"_a,
+                "trim"_a = true);
+        mod.def("assembleDetector", &assembleDetector<ImageT>, "destImage"_a, "rawImage"_a, "detector"_a,
+                "trim"_a = true, "nThreads"_a = 1);
+    });
+}
+
+template <typename PixelT>
+void declareAssemblePixel(lsst::utils::python::WrapperCollection &wrappers) {
+    declareAssemble<image::Image<PixelT>>(wrappers);
+    declareAssemble<image::MaskedImage<PixelT>>(wrappers);
+    declareAssemble<image::Exposure<PixelT>>(wrappers);
+}
+
+}  // namespace
+
+void wrapAssembleImage(lsst::utils::python::WrapperCollection &wrappers) {
+    // lsst.afw.image already depends on this module (for Detector), so we
+    // do not add a signature dependency on it here.
+    declareAssemblePixel<std::uint16_t>(wrappers);
+    declareAssemblePixel<int>(wrappers);
+    declareAssemblePixel<std::uint64_t>(wrappers);
+    declareAssemblePixel<float>(wrappers);
+    declareAssemblePixel<double>(wrappers);
+    declareAssemble<image::Mask<image::MaskPixel>>(wrappers);
+}
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
@@ -22,31 +22,7 @@
 __all__ = ['assembleAmplifierImage', 'assembleAmplifierRawImage',
            'makeUpdatedDetector', 'AmplifierIsolator']
 
-# dict of doFlip: slice
-_SliceDict = {
-    False: slice(None, None, 1),
-    True: slice(None, None, -1),
-}
-
-
-def _insertPixelChunk(outView, inView, amplifier, hasArrays):
-    # For the sake of simplicity and robustness, this code does not short-circuit the case flipX=flipY=False.
-    # However, it would save a bit of time, including the cost of making numpy array views.
-    # If short circuiting is wanted, do it here.
-
-    xSlice = _SliceDict[amplifier.getRawFlipX()]
-    ySlice = _SliceDict[amplifier.getRawFlipY()]
-    if hasArrays:
-        # MaskedImage
-        inArrList = inView.getArrays()
-        outArrList = outView.getArrays()
-    else:
-        inArrList = [inView.getArray()]
-        outArrList = [outView.getArray()]
-
-    for inArr, outArr in zip(inArrList, outArrList):
-        # y,x because numpy arrays are transposed w.r.t. afw Images
-        outArr[:] = inArr[ySlice, xSlice]
+from ._cameraGeom import assembleAmplifier
 
 
 def assembleAmplifierImage(destImage, rawImage, amplifier):
@@ -70,11 +46,7 @@ def assembleAmplifierImage(destImage, rawImage, amplifier):
     if type(destImage.Factory) != type(rawImage.Factory):  # noqa: E721
         raise RuntimeError(f"destImage type = {type(destImage.Factory).__name__} != "
                            f"{type(rawImage.Factory).__name__} = rawImage type")
-    inView = rawImage.Factory(rawImage, amplifier.getRawDataBBox())
-    outView = destImage.Factory(destImage, amplifier.getBBox())
-
-    _insertPixelChunk(outView, inView, amplifier,
-                      hasattr(rawImage, "getArrays"))
+    assembleAmplifier(destImage, rawImage, amplifier, trim=True)
 
 
 def assembleAmplifierRawImage(destImage, rawImage, amplifier):
@@ -103,14 +75,7 @@ def assembleAmplifierRawImage(destImage, rawImage, amplifier):
     if type(destImage.Factory) != type(rawImage.Factory):  # noqa: E721
         raise RuntimeError(f"destImage type = {type(destImage.Factory).__name__} != "
                            f"{type(rawImage.Factory).__name__} = rawImage type")
-    inBBox = amplifier.getRawBBox()
-    inView = rawImage.Factory(rawImage, inBBox)
-    outBBox = amplifier.getRawBBox()
-    outBBox.shift(amplifier.getRawXYOffset())
-    outView = destImage.Factory(destImage, outBBox)
-
-    _insertPixelChunk(outView, inView, amplifier,
-                      hasattr(rawImage, "getArrays"))
+    assembleAmplifier(destImage, rawImage, amplifier, trim=False)
 
 
 def makeUpdatedDetector(ccd):
@@ -203,25 +168,16 @@ class AmplifierIsolator:
         transformed : image-like
             Transformed image of the same type as ``subimage``.
         """
-        from lsst.afw.math import flipImage
-        if hasattr(subimage, "getMaskedImage"):
-            # flipImage doesn't support Exposure natively.
-            # And sadly, there's no way to write to an existing MaskedImage,
-            # so we need to make yet another copy.
-            result = subimage.clone()
-            result.setMaskedImage(
-                flipImage(
-                    subimage.getMaskedImage(),
-                    self._amplifier_comparison & self._amplifier_comparison.FLIPPED_X,
-                    self._amplifier_comparison & self._amplifier_comparison.FLIPPED_Y,
-                )
-            )
-        else:
-            result = flipImage(
-                subimage,
-                self._amplifier_comparison & self._amplifier_comparison.FLIPPED_X,
-                self._amplifier_comparison & self._amplifier_comparison.FLIPPED_Y,
-            )
+        from lsst.afw.math import flipImageInPlace
+        flipX = bool(self._amplifier_comparison & self._amplifier_comparison.FLIPPED_X)
+        flipY = bool(self._amplifier_comparison & self._amplifier_comparison.FLIPPED_Y)
+        result = subimage.clone()
+        if flipX or flipY:
+            if hasattr(result, "getMaskedImage"):
+                # flipImageInPlace doesn't support Exposure natively.
+                flipImageInPlace(result.getMaskedImage(), flipX, flipY)
+            else:
+                flipImageInPlace(result, flipX, flipY)
         if self._is_parent_trimmed:
             result.setXY0(self._amplifier.getBBox().getMin())
         else:
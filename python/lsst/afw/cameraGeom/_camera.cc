@@ -53,7 +53,8 @@ void wrapCamera(lsst::utils::python::WrapperCollection &wrappers) {
         cls.def("getName", &Camera::getName);
         cls.def("getPupilFactoryName", &Camera::getPupilFactoryName);
         cls.def("findDetectors", &Camera::findDetectors, "point"_a, "cameraSys"_a);
-        cls.def("findDetectorsList", &Camera::findDetectorsList, "pointList"_a, "cameraSys"_a);
+        cls.def("findDetectorsList", &Camera::findDetectorsList, "pointList"_a, "cameraSys"_a,
+                "nThreads"_a = 1);
         // transform methods are wrapped with lambdas that translate exceptions for backwards compatibility
         cls.def(
                 "getTransform",
@@ -28,8 +28,10 @@ namespace afw {
 namespace cameraGeom {
 
 void wrapAmplifier(lsst::utils::python::WrapperCollection &);
+void wrapAssembleImage(lsst::utils::python::WrapperCollection &);
 void wrapCamera(lsst::utils::python::WrapperCollection &);
 void wrapCameraSys(lsst::utils::python::WrapperCollection &);
+void wrapCrosstalk(lsst::utils::python::WrapperCollection &);
 void wrapDetector(lsst::utils::python::WrapperCollection &);
 void wrapDetectorCollection(lsst::utils::python::WrapperCollection &);
 void wrapOrientation(lsst::utils::python::WrapperCollection &);
@@ -44,6 +46,8 @@ PYBIND11_MODULE(_cameraGeom, mod) {
     wrapCameraSys(wrappers);
     wrapOrientation(wrappers);
     wrapTransformMap(wrappers);
+    wrapAssembleImage(wrappers);
+    wrapCrosstalk(wrappers);
     wrappers.finish();
 }
 }  // namespace cameraGeom
@@ -0,0 +1,68 @@
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+
+#include <pybind11/pybind11.h>
+#include <lsst/utils/python.h>
+
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/image/Exposure.h"
+#include "lsst/afw/cameraGeom/crosstalk.h"
+
+namespace py = pybind11;
+using namespace py::literals;
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+namespace {
+
+template <typename ImageT>
+void declareSubtractCrosstalk(lsst::utils::python::WrapperCollection &wrappers) {
+    wrappers.wrap([](auto &mod) {
+        mod.def("subtractCrosstalk", &subtractCrosstalk<ImageT>, "image"_a, "detector"_a, "trim"_a = true,
+                "threshold"_a = -std::numeric_limits<double>::infinity(), "sourceMask"_a = 0,
+                "nThreads"_a = 1);
+    });
+}
+
+template <typename PixelT>
+void declareSubtractCrosstalkPixel(lsst::utils::python::WrapperCollection &wrappers) {
+    declareSubtractCrosstalk<image::Image<PixelT>>(wrappers);
+    declareSubtractCrosstalk<image::MaskedImage<PixelT>>(wrappers);
+    declareSubtractCrosstalk<image::Exposure<PixelT>>(wrappers);
+}
+
+}  // namespace
+
+void wrapCrosstalk(lsst::utils::python::WrapperCollection &wrappers) {
+    declareSubtractCrosstalkPixel<float>(wrappers);
+    declareSubtractCrosstalkPixel<double>(wrappers);
+}
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
@@ -85,7 +85,7 @@ void declareImageCompression(lsst::utils::python::WrapperCollection &wrappers) {
 
 template <typename T>
 void declareImageScalingOptionsTemplates(py::class_<ImageScalingOptions> &cls) {
-    cls.def("determine", &ImageScalingOptions::determine<T>);
+    cls.def("determine", &ImageScalingOptions::determine<T>, "image"_a, "mask"_a = nullptr);
 }
 
 void declareImageScalingOptions(lsst::utils::python::WrapperCollection &wrappers) {
@@ -94,10 +94,10 @@ void declareImageScalingOptions(lsst::utils::python::WrapperCollection &wrappers
             [](auto &mod, auto &cls) {
                 cls.def(py::init<>());
                 cls.def(py::init<ImageScalingOptions::ScalingAlgorithm, int, std::vector<std::string> const &,
-                                 unsigned long, float, float, bool, double, double>(),
+                                 unsigned long, float, float, bool, double, double, std::size_t>(),
                         "algorithm"_a, "bitpix"_a, "maskPlanes"_a = std::vector<std::string>(), "seed"_a = 1,
                         "quantizeLevel"_a = 4.0, "quantizePad"_a = 5.0, "fuzz"_a = true, "bscale"_a = 1.0,
-                        "bzero"_a = 0.0);
+                        "bzero"_a = 0.0, "statsSamples"_a = 0);
 
                 cls.def_readonly("algorithm", &ImageScalingOptions::algorithm);
                 cls.def_readonly("bitpix", &ImageScalingOptions::bitpix);
@@ -108,6 +108,7 @@ void declareImageScalingOptions(lsst::utils::python::WrapperCollection &wrappers
                 cls.def_readonly("fuzz", &ImageScalingOptions::fuzz);
                 cls.def_readonly("bscale", &ImageScalingOptions::bscale);
                 cls.def_readonly("bzero", &ImageScalingOptions::bzero);
+                cls.def_readonly("statsSamples", &ImageScalingOptions::statsSamples);
 
                 declareImageScalingOptionsTemplates<float>(cls);
                 declareImageScalingOptionsTemplates<double>(cls);
@@ -244,6 +245,10 @@ void declareFitsModule(lsst::utils::python::WrapperCollection &wrappers) {
                 "fileName"_a, "hdu"_a = DEFAULT_HDU, "strip"_a = false);
         mod.def("setAllowImageCompression", &setAllowImageCompression, "allow"_a);
         mod.def("getAllowImageCompression", &getAllowImageCompression);
+        mod.def("setImageReadThreads", &setImageReadThreads, "nThreads"_a);
+        mod.def("getImageReadThreads", &getImageReadThreads);
+        mod.def("setImageWriteThreads", &setImageWriteThreads, "nThreads"_a);
+        mod.def("getImageWriteThreads", &getImageWriteThreads);
 
         mod.def("compressionAlgorithmFromString", &compressionAlgorithmFromString);
         mod.def("compressionAlgorithmToString", &compressionAlgorithmToString);
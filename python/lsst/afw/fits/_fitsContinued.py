@@ -54,4 +54,5 @@ class ImageScalingOptions:  # noqa: F811
         return (f"{self.__class__.__name__}(algorithm={scalingAlgorithmToString(self.algorithm)!r}, "
                 f"bitpix={self.bitpix}, maskPlanes={self.maskPlanes}, seed={self.seed} "
                 f"quantizeLevel={self.quantizeLevel}, quantizePad={self.quantizePad}, "
-                f"fuzz={self.fuzz}, bscale={self.bscale}, bzero={self.bzero})")
+                f"fuzz={self.fuzz}, bscale={self.bscale}, bzero={self.bzero}, "
+                f"statsSamples={self.statsSamples})")
@@ -28,6 +28,8 @@
 
 #include <pybind11/stl.h>
 
+#include "ndarray/pybind11.h"
+
 #include "lsst/pex/exceptions/Runtime.h"
 #include "lsst/pex/exceptions/python/Exception.h"
 #include "lsst/geom/Box.h"
@@ -74,7 +76,14 @@ void declarePolygon(lsst::utils::python::WrapperCollection &wrappers) {
                 cls.def("calculatePerimeter", &Polygon::calculatePerimeter);
                 cls.def("getVertices", &Polygon::getVertices);
                 cls.def("getEdges", &Polygon::getEdges);
-                cls.def("contains", &Polygon::contains);
+                cls.def("contains", (bool (Polygon::*)(Polygon::Point const &) const) & Polygon::contains,
+                        "point"_a);
+                cls.def("contains",
+                        (ndarray::Array<bool, 1, 1>(Polygon::*)(ndarray::Array<double const, 1> const &,
+                                                                ndarray::Array<double const, 1> const &)
+                                 const) &
+                                Polygon::contains,
+                        "x"_a, "y"_a);
                 cls.def("overlaps", (bool (Polygon::*)(Polygon const &) const) & Polygon::overlaps);
                 cls.def("overlaps", (bool (Polygon::*)(Polygon::Box const &) const) & Polygon::overlaps);
                 cls.def("intersectionSingle", (std::shared_ptr<Polygon>(Polygon::*)(Polygon const &) const) &
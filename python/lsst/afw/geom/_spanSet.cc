@@ -186,6 +186,28 @@ void declareMaskMethods(PyClass &cls) {
     declareUnionMethod<Pixel>(cls);
 }
 
+template <typename PyClass>
+void declareRunLengthMaskMethods(PyClass &cls) {
+    using image::RunLengthMask;
+    using image::MaskPixel;
+    cls.def("setMask", (void (SpanSet::*)(RunLengthMask &, MaskPixel) const) & SpanSet::setMask, "target"_a,
+            "bitmask"_a);
+    cls.def("clearMask", (void (SpanSet::*)(RunLengthMask &, MaskPixel) const) & SpanSet::clearMask,
+            "target"_a, "bitmask"_a);
+    cls.def("intersect",
+            (std::shared_ptr<SpanSet>(SpanSet::*)(RunLengthMask const &, MaskPixel) const) &
+                    SpanSet::intersect,
+            "other"_a, "bitmask"_a);
+    cls.def("intersectNot",
+            (std::shared_ptr<SpanSet>(SpanSet::*)(RunLengthMask const &, MaskPixel) const) &
+                    SpanSet::intersectNot,
+            "other"_a, "bitmask"_a);
+    cls.def("union",
+            (std::shared_ptr<SpanSet>(SpanSet::*)(RunLengthMask const &, MaskPixel) const) &
+                    SpanSet::union_,
+            "other"_a, "bitmask"_a);
+}
+
 template <typename Pixel, typename PyClass>
 void declareImageTypes(PyClass &cls) {
     declareFlattenMethod<Pixel>(cls);
@@ -318,6 +340,7 @@ void declareSpanSet(lsst::utils::python::WrapperCollection &wrappers) {
         // Instantiate all the templates
 
         declareMaskMethods<MaskPixel>(cls);
+        declareRunLengthMaskMethods(cls);
 
         declareImageTypes<std::uint16_t>(cls);
         declareImageTypes<std::uint64_t>(cls);
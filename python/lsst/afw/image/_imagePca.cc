@@ -53,6 +53,8 @@ static void declareImagePca(lsst::utils::python::WrapperCollection &wrappers, st
                 cls.def("getDimensions", &ImagePca<ImageT>::getDimensions);
                 cls.def("getMean", &ImagePca<ImageT>::getMean);
                 cls.def("analyze", &ImagePca<ImageT>::analyze);
+                cls.def("setIncremental", &ImagePca<ImageT>::setIncremental, "incremental"_a);
+                cls.def("isIncremental", &ImagePca<ImageT>::isIncremental);
                 cls.def("updateBadPixels", &ImagePca<ImageT>::updateBadPixels);
                 cls.def("getEigenValues", &ImagePca<ImageT>::getEigenValues);
                 cls.def("getEigenImages", &ImagePca<ImageT>::getEigenImages);
@@ -170,6 +170,8 @@ void declarePhotoCalib(lsst::utils::python::WrapperCollection &wrappers) {
 
                 cls.def("calibrateImage", &PhotoCalib::calibrateImage, "maskedImage"_a,
                         "includeScaleUncertainty"_a = true);
+                cls.def("calibrateImageInPlace", &PhotoCalib::calibrateImageInPlace, "maskedImage"_a,
+                        "includeScaleUncertainty"_a = true);
 
                 cls.def("calibrateCatalog",
                         py::overload_cast<afw::table::SourceCatalog const &,
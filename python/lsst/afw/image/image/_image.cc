@@ -29,6 +29,7 @@
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/ImageSlice.h"
 #include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/SharedMemory.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/python/indexing.h"
 
@@ -222,6 +223,8 @@ static void declareMask(lsst::utils::python::WrapperCollection &wrappers, std::s
         cls.def_static("readFits",
                        (Mask<MaskPixelT>(*)(fits::MemFileManager &, int))Mask<MaskPixelT>::readFits,
                        "manager"_a, "hdu"_a = fits::DEFAULT_HDU);
+        cls.def_static("makeShared", &makeSharedMask, "name"_a, "bbox"_a);
+        cls.def_static("attachShared", &attachSharedMask, "name"_a, "readOnly"_a = true);
         cls.def_static("interpret", Mask<MaskPixelT>::interpret);
         cls.def("subset", &Mask<MaskPixelT>::subset, "bbox"_a, "origin"_a = PARENT);
         cls.def("getAsString", &Mask<MaskPixelT>::getAsString);
@@ -343,6 +346,8 @@ static PyImage<PixelT> declareImage(lsst::utils::python::WrapperCollection &wrap
                        "filename"_a, "hdu"_a = fits::DEFAULT_HDU);
         cls.def_static("readFits", (Image<PixelT>(*)(fits::MemFileManager &, int))Image<PixelT>::readFits,
                        "manager"_a, "hdu"_a = fits::DEFAULT_HDU);
+        cls.def_static("makeShared", &makeSharedImage<PixelT>, "name"_a, "bbox"_a);
+        cls.def_static("attachShared", &attachSharedImage<PixelT>, "name"_a, "readOnly"_a = true);
         cls.def("sqrt", &Image<PixelT>::sqrt);
     });
 }
@@ -503,7 +508,10 @@ void wrapImage(lsst::utils::python::WrapperCollection &wrappers) {
 
     // Note: wrap both the Image and MaskedImage versions of imagesOverlap in the MaskedImage wrapper,
     // as wrapping the Image version here results in it being invisible in lsst.afw.image
-    wrappers.wrap([](auto &mod) { mod.def("bboxFromMetadata", &bboxFromMetadata); });
+    wrappers.wrap([](auto &mod) {
+        mod.def("bboxFromMetadata", &bboxFromMetadata);
+        mod.def("unlinkSharedMemory", &unlinkSharedMemory, "name"_a);
+    });
 }
 }  // namespace image
 }  // namespace afw
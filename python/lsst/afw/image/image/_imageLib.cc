@@ -30,11 +30,13 @@ namespace image {
 
 void wrapImage(lsst::utils::python::WrapperCollection &);
 void wrapImageSlice(lsst::utils::python::WrapperCollection &);
+void wrapRunLengthMask(lsst::utils::python::WrapperCollection &);
 
 PYBIND11_MODULE(_imageLib, mod) {
     lsst::utils::python::WrapperCollection wrappers(mod, "lsst.afw.image.image");
     wrapImage(wrappers);
     wrapImageSlice(wrappers);
+    wrapRunLengthMask(wrappers);
     wrappers.finish();
 }
 }  // namespace image
@@ -0,0 +1,72 @@
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+#include "lsst/utils/python.h"
+
+#include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/image/RunLengthMask.h"
+
+namespace py = pybind11;
+
+using namespace py::literals;
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+void wrapRunLengthMask(lsst::utils::python::WrapperCollection &wrappers) {
+    wrappers.addSignatureDependency("lsst.geom");
+    using PyRunLengthMask = py::class_<RunLengthMask, std::shared_ptr<RunLengthMask>>;
+    wrappers.wrapType(PyRunLengthMask(wrappers.module, "RunLengthMask"), [](auto &mod, auto &cls) {
+        cls.def(py::init<lsst::geom::Box2I const &, RunLengthMask::MaskPlaneDict const &>(), "bbox"_a,
+                "planeDefs"_a = RunLengthMask::MaskPlaneDict());
+        cls.def(py::init<Mask<MaskPixel> const &>(), "mask"_a);
+        cls.def(py::init<RunLengthMask const &>(), "other"_a);
+
+        cls.def("__ior__", [](RunLengthMask &self, RunLengthMask const &other) { return self |= other; });
+        cls.def("__ior__", [](RunLengthMask &self, MaskPixel other) { return self |= other; });
+        cls.def("__iand__", [](RunLengthMask &self, RunLengthMask const &other) { return self &= other; });
+        cls.def("__iand__", [](RunLengthMask &self, MaskPixel other) { return self &= other; });
+        cls.def("__eq__", &RunLengthMask::operator==, py::is_operator());
+        cls.def("__ne__", &RunLengthMask::operator!=, py::is_operator());
+
+        cls.def("getBBox", &RunLengthMask::getBBox);
+        cls.def("getMaskPlaneDict", &RunLengthMask::getMaskPlaneDict);
+        cls.def("getPlaneBitMask", &RunLengthMask::getPlaneBitMask, "name"_a);
+        cls.def("toMask", &RunLengthMask::toMask);
+        cls.def("get", &RunLengthMask::get, "point"_a);
+        cls.def("any", &RunLengthMask::any, "bitmask"_a);
+        cls.def("getUsedBits", &RunLengthMask::getUsedBits);
+        cls.def("getSpanSet", &RunLengthMask::getSpanSet, "bitmask"_a);
+        cls.def("getNumSpans", &RunLengthMask::getNumSpans);
+        cls.def("setSpanSet", &RunLengthMask::setSpanSet, "spans"_a, "bitmask"_a);
+        cls.def("clearSpanSet", &RunLengthMask::clearSpanSet, "spans"_a, "bitmask"_a);
+    });
+}
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
@@ -27,6 +27,7 @@
 
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/image/SharedMemory.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -191,6 +192,9 @@ PyMaskedImage<ImagePixelT> declareMaskedImage(lsst::utils::python::WrapperCollec
 
                 cls.def_static("readFits", (MI(*)(std::string const &))MI::readFits, "filename"_a);
                 cls.def_static("readFits", (MI(*)(fits::MemFileManager &))MI::readFits, "manager"_a);
+                cls.def_static("makeShared", &makeSharedMaskedImage<ImagePixelT>, "name"_a, "bbox"_a);
+                cls.def_static("attachShared", &attachSharedMaskedImage<ImagePixelT>, "name"_a,
+                               "readOnly"_a = true);
                 cls.def("getImage", &MI::getImage);
                 cls.def("setImage", &MI::setImage);
                 cls.def_property("image", &MI::getImage, &MI::setImage);
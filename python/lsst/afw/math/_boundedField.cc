@@ -78,6 +78,7 @@ void declareBoundedField(lsst::utils::python::WrapperCollection &wrappers) {
                                     BoundedField::evaluate);
         cls.def("evaluate",
                 (double (BoundedField::*)(lsst::geom::Point2D const &) const) & BoundedField::evaluate);
+        cls.def("evaluateGrid", &BoundedField::evaluateGrid, "x"_a, "y"_a);
         cls.def("integrate", &BoundedField::integrate);
         cls.def("mean", &BoundedField::mean);
         cls.def("getBBox", &BoundedField::getBBox);
@@ -21,6 +21,7 @@
  */
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <lsst/utils/python.h>
 
 #include "lsst/afw/image/Image.h"
@@ -52,8 +53,10 @@ static void declareRotateImageBy90(lsst::utils::python::WrapperCollection &wrapp
 
 template <typename ImageT>
 static void declareFlipImage(lsst::utils::python::WrapperCollection &wrappers) {
-    wrappers.wrap(
-            [](auto &mod) { mod.def("flipImage", flipImage<ImageT>, "inImage"_a, "flipLR"_a, "flipTB"_a); });
+    wrappers.wrap([](auto &mod) {
+        mod.def("flipImage", flipImage<ImageT>, "inImage"_a, "flipLR"_a, "flipTB"_a);
+        mod.def("flipImageInPlace", flipImageInPlace<ImageT>, "image"_a, "flipLR"_a, "flipTB"_a);
+    });
 }
 
 template <typename ImageT>
@@ -67,6 +70,7 @@ static void declareBinImage(lsst::utils::python::WrapperCollection &wrappers) {
                 (std::shared_ptr<ImageT>(*)(ImageT const &, int const,
                                             lsst::afw::math::Property const))binImage<ImageT>,
                 "inImage"_a, "binsize"_a, "flags"_a = lsst::afw::math::MEAN);
+        mod.def("binImagePyramid", binImagePyramid<ImageT>, "inImage"_a, "nLevels"_a);
     });
 }
 }  // namespace
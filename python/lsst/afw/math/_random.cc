@@ -46,6 +46,26 @@ void declareRandomImage(lsst::utils::python::WrapperCollection &wrappers) {
         mod.def("randomGaussianImage", (void (*)(ImageT *, Random &))randomGaussianImage<ImageT>);
         mod.def("randomChisqImage", (void (*)(ImageT *, Random &, double const))randomChisqImage<ImageT>);
         mod.def("randomPoissonImage", (void (*)(ImageT *, Random &, double const))randomPoissonImage<ImageT>);
+
+        mod.def("randomUniformImage", (void (*)(ImageT *, std::uint64_t, int))randomUniformImage<ImageT>,
+                "image"_a, "seed"_a, "nThreads"_a = 1);
+        mod.def("randomUniformPosImage",
+                (void (*)(ImageT *, std::uint64_t, int))randomUniformPosImage<ImageT>, "image"_a, "seed"_a,
+                "nThreads"_a = 1);
+        mod.def("randomUniformIntImage",
+                (void (*)(ImageT *, std::uint64_t, unsigned long, int))randomUniformIntImage<ImageT>,
+                "image"_a, "seed"_a, "n"_a, "nThreads"_a = 1);
+        mod.def("randomFlatImage",
+                (void (*)(ImageT *, std::uint64_t, double const, double const, int))randomFlatImage<ImageT>,
+                "image"_a, "seed"_a, "a"_a, "b"_a, "nThreads"_a = 1);
+        mod.def("randomGaussianImage", (void (*)(ImageT *, std::uint64_t, int))randomGaussianImage<ImageT>,
+                "image"_a, "seed"_a, "nThreads"_a = 1);
+        mod.def("randomChisqImage",
+                (void (*)(ImageT *, std::uint64_t, double const, int))randomChisqImage<ImageT>, "image"_a,
+                "seed"_a, "nu"_a, "nThreads"_a = 1);
+        mod.def("randomPoissonImage",
+                (void (*)(ImageT *, std::uint64_t, double const, int))randomPoissonImage<ImageT>, "image"_a,
+                "seed"_a, "mu"_a, "nThreads"_a = 1);
     });
 }
 
@@ -82,6 +82,16 @@ class Catalog(metaclass=TemplateMeta):
         return self._columns
     columns = property(__getColumns, doc="a column view of the catalog")
 
+    def makeContiguous(self):
+        """Move the data of all records into a single block of memory, in
+        catalog order, so that column access is always possible.
+
+        Record objects are not replaced, but any arrays previously obtained
+        from the records or from column views no longer refer to their data.
+        """
+        self._columns = None
+        self._makeContiguous()
+
     def __getitem__(self, key):
         """Return the record at index key if key is an integer,
         return a column if `key` is a string field name or Key,
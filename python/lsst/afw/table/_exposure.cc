@@ -22,6 +22,7 @@
  */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 #include "ndarray/pybind11.h"
 
 #include <memory>
@@ -167,9 +168,34 @@ PyExposureCatalog declareExposureCatalog(WrapperCollection &wrappers) {
                         (Catalog(Catalog::*)(lsst::geom::Point2D const &, geom::SkyWcs const &, bool) const) &
                                 Catalog::subsetContaining,
                         "point"_a, "wcs"_a, "includeValidPolygon"_a = false);
+                cls.def("subsetContaining",
+                        (std::vector<Catalog>(Catalog::*)(std::vector<lsst::geom::SpherePoint> const &, bool)
+                                 const) &
+                                Catalog::subsetContaining,
+                        "coords"_a, "includeValidPolygon"_a = false);
             });
 };
 
+void declareExposureSkyIndex(WrapperCollection &wrappers) {
+    using Catalog = ExposureCatalogT<ExposureRecord>;
+    wrappers.wrapType(
+            py::class_<ExposureSkyIndex, std::shared_ptr<ExposureSkyIndex>>(wrappers.module,
+                                                                            "ExposureSkyIndex"),
+            [](auto &mod, auto &cls) {
+                cls.def(py::init<Catalog const &>(), "catalog"_a);
+                cls.def("getCatalog", &ExposureSkyIndex::getCatalog);
+                cls.def("subsetContaining",
+                        (Catalog(ExposureSkyIndex::*)(lsst::geom::SpherePoint const &, bool) const) &
+                                ExposureSkyIndex::subsetContaining,
+                        "coord"_a, "includeValidPolygon"_a = false);
+                using SpherePoints = std::vector<lsst::geom::SpherePoint>;
+                cls.def("subsetContaining",
+                        (std::vector<Catalog>(ExposureSkyIndex::*)(SpherePoints const &, bool) const) &
+                                ExposureSkyIndex::subsetContaining,
+                        "coords"_a, "includeValidPolygon"_a = false);
+            });
+}
+
 }  // anonymous namespace
 
 void wrapExposure(WrapperCollection &wrappers) {
@@ -192,6 +218,8 @@ void wrapExposure(WrapperCollection &wrappers) {
     clsExposureCatalog.attr("Record") = clsExposureRecord;
     clsExposureCatalog.attr("Table") = clsExposureTable;
     clsExposureCatalog.attr("ColumnView") = clsExposureColumnView;
+
+    declareExposureSkyIndex(wrappers);
 }
 
 }  // namespace table
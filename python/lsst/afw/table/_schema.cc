@@ -470,6 +470,21 @@ void declareSchema(WrapperCollection &wrappers) {
                 throw py::error_already_set();
             }
         });
+        cls.def("findKeys", [](Schema const &self, std::vector<std::string> const &names) {
+            py::list result;
+            try {
+                for (auto const &name : names) {
+                    MakePythonSchemaItem func;
+                    self.findAndApply(name, func);
+                    result.append(func.result.attr("key"));
+                }
+            } catch (pex::exceptions::NotFoundError &err) {
+                // Be consistent with find.
+                PyErr_SetString(PyExc_KeyError, err.what());
+                throw py::error_already_set();
+            }
+            return result;
+        }, "names"_a);
         cls.def("getNames", &Schema::getNames, "topOnly"_a = false);
         cls.def("getAliasMap", &Schema::getAliasMap);
         cls.def("setAliasMap", &Schema::setAliasMap, "aliases"_a);
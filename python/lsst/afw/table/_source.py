@@ -108,6 +108,101 @@ class SourceCatalog:
         except TypeError:
             return _getChildrenWithoutChecking(parent)
 
+    def _getSlotColumn(self, key):
+        """Return the values of a slot field for all records, as
+        ``self[key]`` does.
+        """
+        if not key.isValid():
+            raise LogicError("Key is not valid (if this is a SourceCatalog, make sure slot aliases have been "
+                             "set up)")
+        return self[key]
+
+    def getPsfInstFlux(self):
+        return self._getSlotColumn(self.table.getPsfFluxSlot().getMeasKey())
+
+    def getPsfInstFluxErr(self):
+        return self._getSlotColumn(self.table.getPsfFluxSlot().getErrKey())
+
+    def getPsfFluxFlag(self):
+        return self._getSlotColumn(self.table.getPsfFluxSlot().getFlagKey())
+
+    def getModelInstFlux(self):
+        return self._getSlotColumn(self.table.getModelFluxSlot().getMeasKey())
+
+    def getModelInstFluxErr(self):
+        return self._getSlotColumn(self.table.getModelFluxSlot().getErrKey())
+
+    def getModelFluxFlag(self):
+        return self._getSlotColumn(self.table.getModelFluxSlot().getFlagKey())
+
+    def getApInstFlux(self):
+        return self._getSlotColumn(self.table.getApFluxSlot().getMeasKey())
+
+    def getApInstFluxErr(self):
+        return self._getSlotColumn(self.table.getApFluxSlot().getErrKey())
+
+    def getApFluxFlag(self):
+        return self._getSlotColumn(self.table.getApFluxSlot().getFlagKey())
+
+    def getGaussianInstFlux(self):
+        return self._getSlotColumn(self.table.getGaussianFluxSlot().getMeasKey())
+
+    def getGaussianInstFluxErr(self):
+        return self._getSlotColumn(self.table.getGaussianFluxSlot().getErrKey())
+
+    def getGaussianFluxFlag(self):
+        return self._getSlotColumn(self.table.getGaussianFluxSlot().getFlagKey())
+
+    def getCalibInstFlux(self):
+        return self._getSlotColumn(self.table.getCalibFluxSlot().getMeasKey())
+
+    def getCalibInstFluxErr(self):
+        return self._getSlotColumn(self.table.getCalibFluxSlot().getErrKey())
+
+    def getCalibFluxFlag(self):
+        return self._getSlotColumn(self.table.getCalibFluxSlot().getFlagKey())
+
+    def getX(self):
+        return self._getSlotColumn(self.table.getCentroidSlot().getMeasKey().getX())
+
+    def getY(self):
+        return self._getSlotColumn(self.table.getCentroidSlot().getMeasKey().getY())
+
+    def getCentroidFlag(self):
+        return self._getSlotColumn(self.table.getCentroidSlot().getFlagKey())
+
+    def getIxx(self):
+        return self._getSlotColumn(self.table.getShapeSlot().getMeasKey().getIxx())
+
+    def getIyy(self):
+        return self._getSlotColumn(self.table.getShapeSlot().getMeasKey().getIyy())
+
+    def getIxy(self):
+        return self._getSlotColumn(self.table.getShapeSlot().getMeasKey().getIxy())
+
+    def getShapeFlag(self):
+        return self._getSlotColumn(self.table.getShapeSlot().getFlagKey())
+
+    def _getPsfShapeComponent(self, suffix):
+        try:
+            key = self.schema.find("slot_PsfShape_" + suffix).key
+        except KeyError:
+            raise LogicError("Key is not valid (if this is a SourceCatalog, make sure slot aliases have been "
+                             "set up)") from None
+        return self._getSlotColumn(key)
+
+    def getPsfIxx(self):
+        return self._getPsfShapeComponent("xx")
+
+    def getPsfIyy(self):
+        return self._getPsfShapeComponent("yy")
+
+    def getPsfIxy(self):
+        return self._getPsfShapeComponent("xy")
+
+    def getPsfShapeFlag(self):
+        return self._getPsfShapeComponent("flag")
+
 
 @continueClass
 class SourceRecord:  # noqa: F811
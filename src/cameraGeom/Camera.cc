@@ -19,11 +19,15 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "lsst/afw/table/io/Persistable.cc"
 #include "lsst/afw/table/io/CatalogVector.h"
 #include "lsst/afw/table/io/InputArchive.h"
 #include "lsst/afw/table/io/OutputArchive.h"
 #include "lsst/afw/cameraGeom/Camera.h"
+#include "lsst/afw/cameraGeom/detail/threads.h"
 
 namespace lsst {
 namespace afw {
@@ -42,34 +46,207 @@ Camera::Builder Camera::rebuild() const {
     return Camera::Builder(*this);
 }
 
+namespace {
+
+// Number of points along each edge of a detector used to find its footprint
+// in FOCAL_PLANE.
+int const FOOTPRINT_EDGE_SAMPLES = 8;
+
+// Padding added to each footprint, as a fraction of its size, to account for
+// any curvature between the edge samples; the index only proposes candidates,
+// so this affects speed but not results.
+double const FOOTPRINT_PADDING = 0.01;
+
+}  // anonymous
+
+/*
+ * Detector footprints in FOCAL_PLANE, bucketed on a regular grid.
+ *
+ * Footprints are the (padded) bounding boxes of the detectors' edges mapped
+ * to FOCAL_PLANE, so any point on a detector lies within its footprint; the
+ * detectors in a grid cell are kept in ID order.
+ */
+class Camera::FocalPlaneIndex {
+public:
+
+    explicit FocalPlaneIndex(DetectorCollection::IdMap const & idMap) {
+        _detectors.reserve(idMap.size());
+        _footprints.reserve(idMap.size());
+        std::vector<std::size_t> unbounded;
+        for (auto const & item : idMap) {
+            auto const & detector = item.second;
+            lsst::geom::Box2D footprint;
+            lsst::geom::Box2D const bbox(detector->getBBox());
+            if (!bbox.isEmpty()) {
+                std::vector<lsst::geom::Point2D> edges;
+                edges.reserve(4*(FOOTPRINT_EDGE_SAMPLES + 1));
+                for (int i = 0; i <= FOOTPRINT_EDGE_SAMPLES; ++i) {
+                    double const x = bbox.getMinX() + i*bbox.getWidth()/FOOTPRINT_EDGE_SAMPLES;
+                    double const y = bbox.getMinY() + i*bbox.getHeight()/FOOTPRINT_EDGE_SAMPLES;
+                    edges.emplace_back(x, bbox.getMinY());
+                    edges.emplace_back(x, bbox.getMaxY());
+                    edges.emplace_back(bbox.getMinX(), y);
+                    edges.emplace_back(bbox.getMaxX(), y);
+                }
+                bool finite = true;
+                for (auto const & point : detector->transform(edges, PIXELS, getNativeCameraSys())) {
+                    finite = finite && std::isfinite(point.getX()) && std::isfinite(point.getY());
+                    footprint.include(point);
+                }
+                if (finite) {
+                    footprint.grow(FOOTPRINT_PADDING*std::max(footprint.getWidth(), footprint.getHeight()));
+                    _bbox.include(footprint);
+                } else {
+                    // We can't bound this detector, so it is a candidate everywhere.
+                    footprint = lsst::geom::Box2D();
+                    unbounded.push_back(_detectors.size());
+                }
+            }
+            _detectors.push_back(detector);
+            _footprints.push_back(footprint);
+        }
+
+        // Aim for about one detector per cell.
+        int const nCells = std::max(1, static_cast<int>(std::ceil(std::sqrt(_detectors.size()))));
+        _nx = _bbox.getWidth() > 0.0 ? nCells : 1;
+        _ny = _bbox.getHeight() > 0.0 ? nCells : 1;
+        _cells.resize(_nx*_ny);
+        for (std::size_t i = 0; i < _detectors.size(); ++i) {
+            bool const isUnbounded = std::binary_search(unbounded.begin(), unbounded.end(), i);
+            if (_footprints[i].isEmpty() && !isUnbounded) {
+                continue;
+            }
+            int const x0 = isUnbounded ? 0 : _getCellX(_footprints[i].getMinX());
+            int const x1 = isUnbounded ? _nx - 1 : _getCellX(_footprints[i].getMaxX());
+            int const y0 = isUnbounded ? 0 : _getCellY(_footprints[i].getMinY());
+            int const y1 = isUnbounded ? _ny - 1 : _getCellY(_footprints[i].getMaxY());
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    _cells[y*_nx + x].push_back(i);
+                }
+            }
+        }
+        _unbounded = std::move(unbounded);
+    }
+
+    std::size_t size() const noexcept { return _detectors.size(); }
+
+    std::shared_ptr<Detector const> const & getDetector(std::size_t i) const { return _detectors[i]; }
+
+    // Return the indices of the detectors that may contain the given FOCAL_PLANE point, in ID order.
+    std::vector<std::size_t> getCandidates(lsst::geom::Point2D const & point) const {
+        std::vector<std::size_t> candidates;
+        if (_bbox.contains(point)) {
+            for (std::size_t i : _cells[_getCellY(point.getY())*_nx + _getCellX(point.getX())]) {
+                if (_footprints[i].contains(point) ||
+                    std::binary_search(_unbounded.begin(), _unbounded.end(), i)) {
+                    candidates.push_back(i);
+                }
+            }
+        } else {
+            candidates = _unbounded;
+        }
+        return candidates;
+    }
+
+private:
+
+    int _getCellX(double x) const {
+        int const i = static_cast<int>((x - _bbox.getMinX())*_nx/_bbox.getWidth());
+        return std::min(std::max(i, 0), _nx - 1);
+    }
+
+    int _getCellY(double y) const {
+        int const i = static_cast<int>((y - _bbox.getMinY())*_ny/_bbox.getHeight());
+        return std::min(std::max(i, 0), _ny - 1);
+    }
+
+    std::vector<std::shared_ptr<Detector const>> _detectors;  // in ID order
+    std::vector<lsst::geom::Box2D> _footprints;  // empty for detectors with no pixels or no bounds
+    std::vector<std::size_t> _unbounded;  // detectors whose footprint could not be computed
+    lsst::geom::Box2D _bbox;  // union of all bounded footprints
+    int _nx = 1;
+    int _ny = 1;
+    std::vector<std::vector<std::size_t>> _cells;  // [y*_nx + x]
+};
+
 Camera::DetectorList Camera::findDetectors(lsst::geom::Point2D const &point,
                                            CameraSys const &cameraSys) const {
     auto nativePoint = transform(point, cameraSys, getNativeCameraSys());
 
     DetectorList detectorList;
-    for (auto const &item : getIdMap()) {
-        auto detector = item.second;
+    for (std::size_t i : _focalPlaneIndex->getCandidates(nativePoint)) {
+        auto const &detector = _focalPlaneIndex->getDetector(i);
         auto pointPixels = detector->transform(nativePoint, getNativeCameraSys(), PIXELS);
         if (lsst::geom::Box2D(detector->getBBox()).contains(pointPixels)) {
-            detectorList.push_back(std::move(detector));
+            detectorList.push_back(detector);
         }
     }
     return detectorList;
 }
 
 std::vector<Camera::DetectorList> Camera::findDetectorsList(std::vector<lsst::geom::Point2D> const &pointList,
-                                                            CameraSys const &cameraSys) const {
+                                                            CameraSys const &cameraSys, int nThreads) const {
+    detail::checkNumThreads(nThreads);
     std::vector<DetectorList> detectorListList(pointList.size());
     auto nativePointList = transform(pointList, cameraSys, getNativeCameraSys());
 
-    for (auto const &item: getIdMap()) {
-        auto const &detector = item.second;
-        auto pointPixelsList = detector->transform(nativePointList, getNativeCameraSys(), PIXELS);
-        for (std::size_t i = 0; i < pointPixelsList.size(); ++i) {
-            auto const &pointPixels = pointPixelsList[i];
-            if (lsst::geom::Box2D(detector->getBBox()).contains(pointPixels)) {
-                detectorListList[i].push_back(detector);
+    // Group the points by candidate detector, so each detector that could
+    // contain any of them needs only one batched transform.
+    auto const &index = *_focalPlaneIndex;
+    std::vector<std::vector<std::size_t>> candidatePoints(index.size());
+    for (std::size_t i = 0; i < nativePointList.size(); ++i) {
+        for (std::size_t j : index.getCandidates(nativePointList[i])) {
+            candidatePoints[j].push_back(i);
+        }
+    }
+
+    // The detector transforms share the camera's AST objects, which must not
+    // be used concurrently, so when using threads give each candidate
+    // detector an independent deep copy of its transform on this thread.
+    // Copying the mapping rather than simplifying it guarantees no AST
+    // sub-objects are shared.
+    using TransformPtr = std::shared_ptr<afw::geom::TransformPoint2ToPoint2 const>;
+    std::vector<TransformPtr> toPixelsList(index.size());
+    for (std::size_t j = 0; j < index.size(); ++j) {
+        if (!candidatePoints[j].empty()) {
+            TransformPtr toPixels = index.getDetector(j)->getTransform(getNativeCameraSys(), PIXELS);
+            if (nThreads > 1) {
+                bool const simplify = false;
+                toPixels = std::make_shared<afw::geom::TransformPoint2ToPoint2>(*toPixels->getMapping(),
+                                                                                simplify);
             }
+            toPixelsList[j] = toPixels;
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> containedPoints(index.size());
+    auto testDetectors = [&](std::size_t begin, std::size_t end) {
+        std::vector<lsst::geom::Point2D> points;
+        for (std::size_t j = begin; j < end; ++j) {
+            auto const &indices = candidatePoints[j];
+            if (indices.empty()) {
+                continue;
+            }
+            points.clear();
+            for (std::size_t i : indices) {
+                points.push_back(nativePointList[i]);
+            }
+            auto const pixelPoints = toPixelsList[j]->applyForward(points);
+            lsst::geom::Box2D const bbox(index.getDetector(j)->getBBox());
+            for (std::size_t k = 0; k < indices.size(); ++k) {
+                if (bbox.contains(pixelPoints[k])) {
+                    containedPoints[j].push_back(indices[k]);
+                }
+            }
+        }
+    };
+    detail::parallelForRanges(index.size(), nThreads, testDetectors);
+
+    // Merge in detector order, so each list is in ID order.
+    for (std::size_t j = 0; j < index.size(); ++j) {
+        for (std::size_t i : containedPoints[j]) {
+            detectorListList[i].push_back(index.getDetector(j));
         }
     }
     return detectorListList;
@@ -179,7 +356,8 @@ Camera::Camera(std::string const & name, DetectorList detectors,
     DetectorCollection(std::move(detectors)),
     _name(name),
     _pupilFactoryName(pupilFactoryName),
-    _transformMap(std::move(transformMap))
+    _transformMap(std::move(transformMap)),
+    _focalPlaneIndex(new FocalPlaneIndex(getIdMap()))
 {}
 
 Camera::Camera(table::io::InputArchive const & archive, table::io::CatalogVector const & catalogs) :
@@ -196,6 +374,7 @@ Camera::Camera(table::io::InputArchive const & archive, table::io::CatalogVector
     _name = record.get(keys.name);
     _pupilFactoryName = record.get(keys.pupilFactoryName);
     _transformMap = archive.get<TransformMap>(record.get(keys.transformMap));
+    _focalPlaneIndex.reset(new FocalPlaneIndex(getIdMap()));
 }
 
 std::string Camera::getPersistenceName() const { return "Camera"; }
@@ -0,0 +1,166 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "boost/format.hpp"
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/Mask.h"
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/image/Exposure.h"
+#include "lsst/afw/cameraGeom/assembleImage.h"
+#include "lsst/afw/cameraGeom/detail/threads.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+namespace {
+
+// Return a shallow copy of the pixels to assemble into or from; Exposures
+// delegate to their MaskedImage.
+template <typename ImageT>
+ImageT getPixels(ImageT const &image) {
+    return image;
+}
+
+template <typename PixelT>
+image::MaskedImage<PixelT> getPixels(image::Exposure<PixelT> const &exposure) {
+    return exposure.getMaskedImage();
+}
+
+// Copy one plane row by row, reading rows in reverse order to flip in y and
+// reversing each row to flip in x.
+template <typename PixelT>
+void copyFlipped(image::ImageBase<PixelT> &out, image::ImageBase<PixelT> const &in, bool flipX, bool flipY) {
+    auto outArray = out.getArray();
+    auto inArray = in.getArray();
+    int const width = out.getWidth();
+    int const height = out.getHeight();
+    for (int y = 0; y < height; ++y) {
+        PixelT const *inRow = inArray[flipY ? height - 1 - y : y].getData();
+        PixelT *outRow = outArray[y].getData();
+        if (flipX) {
+            std::reverse_copy(inRow, inRow + width, outRow);
+        } else {
+            std::copy(inRow, inRow + width, outRow);
+        }
+    }
+}
+
+template <typename PixelT>
+void copyFlipped(image::MaskedImage<PixelT> &out, image::MaskedImage<PixelT> const &in, bool flipX,
+                 bool flipY) {
+    copyFlipped(*out.getImage(), *in.getImage(), flipX, flipY);
+    copyFlipped(*out.getMask(), *in.getMask(), flipX, flipY);
+    copyFlipped(*out.getVariance(), *in.getVariance(), flipX, flipY);
+}
+
+// Views of the source and destination of a single amplifier.
+template <typename PixelsT>
+struct AmplifierChunk {
+    PixelsT out;
+    PixelsT in;
+    bool flipX;
+    bool flipY;
+
+    void copy() { copyFlipped(out, in, flipX, flipY); }
+};
+
+template <typename PixelsT>
+AmplifierChunk<PixelsT> makeChunk(PixelsT const &destImage, PixelsT const &rawImage,
+                                  Amplifier const &amplifier, bool trim) {
+    lsst::geom::Box2I inBBox;
+    lsst::geom::Box2I outBBox;
+    if (trim) {
+        inBBox = amplifier.getRawDataBBox();
+        outBBox = amplifier.getBBox();
+    } else {
+        inBBox = amplifier.getRawBBox();
+        outBBox = amplifier.getRawBBox();
+        outBBox.shift(amplifier.getRawXYOffset());
+    }
+    if (inBBox.getDimensions() != outBBox.getDimensions()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Raw bbox %s and assembled bbox %s of amplifier %s differ in size") %
+                           inBBox % outBBox % amplifier.getName())
+                                  .str());
+    }
+    return AmplifierChunk<PixelsT>{PixelsT(destImage, outBBox, image::PARENT, false),
+                                   PixelsT(rawImage, inBBox, image::PARENT, false), amplifier.getRawFlipX(),
+                                   amplifier.getRawFlipY()};
+}
+
+}  // namespace
+
+template <typename ImageT>
+void assembleAmplifier(ImageT &destImage, ImageT const &rawImage, Amplifier const &amplifier, bool trim) {
+    makeChunk(getPixels(destImage), getPixels(rawImage), amplifier, trim).copy();
+}
+
+template <typename ImageT>
+void assembleDetector(ImageT &destImage, ImageT const &rawImage, Detector const &detector, bool trim,
+                      int nThreads) {
+    auto const destPixels = getPixels(destImage);
+    auto const rawPixels = getPixels(rawImage);
+    using PixelsT = std::remove_const_t<decltype(destPixels)>;
+
+    // Make (and hence check) all views before copying anything.
+    std::vector<AmplifierChunk<PixelsT>> chunks;
+    chunks.reserve(detector.getAmplifiers().size());
+    for (auto const &amplifier : detector.getAmplifiers()) {
+        chunks.push_back(makeChunk(destPixels, rawPixels, *amplifier, trim));
+    }
+
+    auto copyChunks = [&chunks](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            chunks[i].copy();
+        }
+    };
+    detail::parallelForRanges(chunks.size(), nThreads, copyChunks);
+}
+
+#define INSTANTIATE(IMAGE)                                                                               \
+    template void assembleAmplifier(IMAGE &, IMAGE const &, Amplifier const &, bool);                    \
+    template void assembleDetector(IMAGE &, IMAGE const &, Detector const &, bool, int);
+
+#define INSTANTIATE_PIXEL(PIXEL)               \
+    INSTANTIATE(image::Image<PIXEL>)           \
+    INSTANTIATE(image::MaskedImage<PIXEL>)     \
+    INSTANTIATE(image::Exposure<PIXEL>)
+
+INSTANTIATE_PIXEL(std::uint16_t)
+INSTANTIATE_PIXEL(int)
+INSTANTIATE_PIXEL(std::uint64_t)
+INSTANTIATE_PIXEL(float)
+INSTANTIATE_PIXEL(double)
+INSTANTIATE(image::Mask<image::MaskPixel>)
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
@@ -0,0 +1,222 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "boost/format.hpp"
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/Exposure.h"
+#include "lsst/afw/cameraGeom/crosstalk.h"
+#include "lsst/afw/cameraGeom/detail/threads.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+namespace {
+
+// The image plane to correct and the mask (if any) used to select source pixels.
+template <typename PixelT>
+struct CrosstalkPlanes {
+    image::Image<PixelT> image;
+    std::shared_ptr<image::Mask<image::MaskPixel> const> mask;
+};
+
+template <typename PixelT>
+CrosstalkPlanes<PixelT> getPlanes(image::Image<PixelT> const &image) {
+    return CrosstalkPlanes<PixelT>{image, nullptr};
+}
+
+template <typename PixelT>
+CrosstalkPlanes<PixelT> getPlanes(image::MaskedImage<PixelT> const &image) {
+    return CrosstalkPlanes<PixelT>{*image.getImage(), image.getMask()};
+}
+
+template <typename PixelT>
+CrosstalkPlanes<PixelT> getPlanes(image::Exposure<PixelT> const &exposure) {
+    return getPlanes(exposure.getMaskedImage());
+}
+
+// The region of an amplifier in the image and the flips that put its readout
+// corner at the lower left.
+struct AmplifierLayout {
+    lsst::geom::Box2I bbox;
+    bool flipX;
+    bool flipY;
+};
+
+AmplifierLayout makeLayout(Amplifier const &amplifier, bool trim) {
+    ReadoutCorner const corner = amplifier.getReadoutCorner();
+    bool const flipX = (corner == ReadoutCorner::LR || corner == ReadoutCorner::UR);
+    bool const flipY = (corner == ReadoutCorner::UL || corner == ReadoutCorner::UR);
+    if (trim) {
+        return AmplifierLayout{amplifier.getBBox(), flipX, flipY};
+    }
+    return AmplifierLayout{amplifier.getRawDataBBox(), flipX != amplifier.getRawFlipX(),
+                           flipY != amplifier.getRawFlipY()};
+}
+
+// Copy the contributing pixels of a source amplifier in readout order (with
+// the readout corner at the lower left), zeroing those that do not pass the
+// threshold and mask cuts.
+template <typename PixelT>
+std::vector<PixelT> makeSourceSnapshot(CrosstalkPlanes<PixelT> const &planes, AmplifierLayout const &layout,
+                                       double threshold, image::MaskPixel sourceMask) {
+    int const width = layout.bbox.getWidth();
+    int const height = layout.bbox.getHeight();
+    image::Image<PixelT> const source(planes.image, layout.bbox, image::PARENT, false);
+    auto const array = source.getArray();
+    bool const useMask = sourceMask != 0 && planes.mask;
+    ndarray::Array<image::MaskPixel const, 2, 1> maskArray;
+    if (useMask) {
+        maskArray = image::Mask<image::MaskPixel>(*planes.mask, layout.bbox, image::PARENT, false).getArray();
+    }
+    std::vector<PixelT> snapshot(static_cast<std::size_t>(width) * height);
+    for (int cy = 0; cy < height; ++cy) {
+        int const y = layout.flipY ? height - 1 - cy : cy;
+        PixelT const *in = array[y].getData();
+        image::MaskPixel const *mask = useMask ? maskArray[y].getData() : nullptr;
+        PixelT *out = snapshot.data() + static_cast<std::size_t>(cy) * width;
+        for (int cx = 0; cx < width; ++cx) {
+            int const x = layout.flipX ? width - 1 - cx : cx;
+            bool const contributes = in[x] > threshold && (!mask || (mask[x] & sourceMask));
+            out[cx] = contributes ? in[x] : 0;
+        }
+    }
+    return snapshot;
+}
+
+template <typename PixelT>
+void subtractCrosstalkPlanes(CrosstalkPlanes<PixelT> const &planes, Detector const &detector, bool trim,
+                             double threshold, image::MaskPixel sourceMask, int nThreads) {
+    // Check this before returning early for detectors without amplifiers.
+    detail::checkNumThreads(nThreads);
+    if (!detector.hasCrosstalk()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Detector %s has no crosstalk coefficients") % detector.getName())
+                                  .str());
+    }
+    auto const coeffs = detector.getCrosstalk();
+    auto const &amplifiers = detector.getAmplifiers();
+    std::size_t const nAmps = amplifiers.size();
+
+    std::vector<AmplifierLayout> layouts;
+    layouts.reserve(nAmps);
+    for (auto const &amplifier : amplifiers) {
+        layouts.push_back(makeLayout(*amplifier, trim));
+        if (layouts.back().bbox.getDimensions() != layouts.front().bbox.getDimensions()) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Amplifier %s has dimensions %s; expected %s") %
+                               amplifier->getName() % layouts.back().bbox.getDimensions() %
+                               layouts.front().bbox.getDimensions())
+                                      .str());
+        }
+    }
+    if (nAmps == 0) {
+        return;
+    }
+    int const width = layouts.front().bbox.getWidth();
+    int const height = layouts.front().bbox.getHeight();
+
+    // Make the victim views first, so bad geometry is caught before anything
+    // is modified.
+    std::vector<image::Image<PixelT>> victims;
+    victims.reserve(nAmps);
+    for (auto const &layout : layouts) {
+        victims.emplace_back(planes.image, layout.bbox, image::PARENT, false);
+    }
+
+    // Snapshot the sources (so all contributions come from the uncorrected
+    // image), skipping those that do not affect any victim.
+    std::vector<std::vector<PixelT>> sources(nAmps);
+    for (std::size_t s = 0; s < nAmps; ++s) {
+        for (std::size_t v = 0; v < nAmps; ++v) {
+            if (v != s && coeffs[v][s] != 0.0f) {
+                sources[s] = makeSourceSnapshot(planes, layouts[s], threshold, sourceMask);
+                break;
+            }
+        }
+    }
+
+    // Correct victims one row at a time: accumulate all contributions to a
+    // row in readout order with contiguous multiply-adds, then subtract them
+    // in the victim's orientation.
+    auto correctVictims = [&](std::size_t begin, std::size_t end) {
+        std::vector<double> accumulator(width);
+        for (std::size_t v = begin; v < end; ++v) {
+            auto array = victims[v].getArray();
+            for (int cy = 0; cy < height; ++cy) {
+                std::fill(accumulator.begin(), accumulator.end(), 0.0);
+                double *acc = accumulator.data();
+                for (std::size_t s = 0; s < nAmps; ++s) {
+                    double const c = coeffs[v][s];
+                    if (s == v || c == 0.0) {
+                        continue;
+                    }
+                    PixelT const *src = sources[s].data() + static_cast<std::size_t>(cy) * width;
+                    for (int x = 0; x < width; ++x) {
+                        acc[x] += c * src[x];
+                    }
+                }
+                int const y = layouts[v].flipY ? height - 1 - cy : cy;
+                PixelT *out = array[y].getData();
+                if (layouts[v].flipX) {
+                    for (int x = 0; x < width; ++x) {
+                        out[x] -= acc[width - 1 - x];
+                    }
+                } else {
+                    for (int x = 0; x < width; ++x) {
+                        out[x] -= acc[x];
+                    }
+                }
+            }
+        }
+    };
+    detail::parallelForRanges(nAmps, nThreads, correctVictims);
+}
+
+}  // namespace
+
+template <typename ImageT>
+void subtractCrosstalk(ImageT &image, Detector const &detector, bool trim, double threshold,
+                       afw::image::MaskPixel sourceMask, int nThreads) {
+    subtractCrosstalkPlanes(getPlanes(image), detector, trim, threshold, sourceMask, nThreads);
+}
+
+#define INSTANTIATE(IMAGE) \
+    template void subtractCrosstalk(IMAGE &, Detector const &, bool, double, image::MaskPixel, int);
+
+#define INSTANTIATE_PIXEL(PIXEL)           \
+    INSTANTIATE(image::Image<PIXEL>)       \
+    INSTANTIATE(image::MaskedImage<PIXEL>) \
+    INSTANTIATE(image::Exposure<PIXEL>)
+
+INSTANTIATE_PIXEL(float)
+INSTANTIATE_PIXEL(double)
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
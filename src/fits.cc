@@ -1,14 +1,24 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <complex>
 #include <cmath>
+#include <exception>
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
 #include <filesystem>
 #include <regex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "fitsio.h"
 extern "C" {
@@ -366,6 +376,8 @@ bool isFitsImageTypeSigned(int constant) {
 }
 
 static bool allowImageCompression = true;
+static int imageReadThreads = 1;
+static int imageWriteThreads = 1;
 
 int fitsTypeForBitpix(int bitpix) {
     switch (bitpix) {
@@ -1419,6 +1431,156 @@ void Fits::readImageImpl(int nAxis, T *data, long *begin, long *end, long *incre
     if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Reading image");
 }
 
+namespace {
+
+// A read-only memory map of a whole file.
+//
+// cfitsio handles cannot be shared between threads, and opening the same file name twice returns
+// handles that share their state, so threads that decompress tiles in parallel each open their own
+// memory file on this mapping instead.
+class FileMapping {
+public:
+    explicit FileMapping(std::string const &fileName) : _data(MAP_FAILED), _size(0) {
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            _size = info.st_size;
+            _data = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+    }
+
+    FileMapping(FileMapping const &) = delete;
+    FileMapping &operator=(FileMapping const &) = delete;
+
+    ~FileMapping() {
+        if (_data != MAP_FAILED) ::munmap(_data, _size);
+    }
+
+    bool isValid() const { return _data != MAP_FAILED; }
+
+    // Open a new, independent cfitsio handle on the mapping, positioned at the given (0-indexed) HDU.
+    fitsfile *open(int hdu, int *status) const {
+        fitsfile *fits = nullptr;
+        void *data = _data;
+        std::size_t size = _size;
+        fits_open_memfile(&fits, "mapped", READONLY, &data, &size, 0, nullptr, status);
+        fits_movabs_hdu(fits, hdu + 1, nullptr, status);
+        return fits;
+    }
+
+private:
+    void *_data;
+    std::size_t _size;
+};
+
+// Read rows [begin[1], end[1]] (1-indexed, inclusive, as for fits_read_subset) of the image in the given
+// HDU through a new handle on the mapping; returns the cfitsio status.
+template <typename T>
+int readMappedImageBand(FileMapping const &mapping, int hdu, T *data, long *begin, long *end) {
+    int status = 0;
+    fitsfile *fits = mapping.open(hdu, &status);
+    T null = NullValue<T>::value;
+    int anyNulls = 0;
+    long increment[2] = {1, 1};
+    fits_read_subset(fits, FitsType<T>::CONSTANT, begin, end, increment, reinterpret_cast<void *>(&null),
+                     data, &anyNulls, &status);
+    if (fits != nullptr) {
+        int closeStatus = 0;
+        fits_close_file(fits, &closeStatus);
+    }
+    return status;
+}
+
+}  // namespace
+
+template <typename T>
+void Fits::readTiledImage(ndarray::Array<T, 2, 2> const &array, ndarray::Vector<int, 2> const &offset) {
+    int const nThreads = getImageReadThreads();
+    int const height = array.template getSize<0>();
+    int const width = array.template getSize<1>();
+    // Concurrent reads need a reentrant cfitsio, and since they reread the file from disk (not through
+    // this handle's buffers), a handle that may hold unwritten changes must be read the usual way.
+    if (nThreads <= 1 || height <= 1 || !fits_is_reentrant() || !isCompressedImage()) {
+        readImage(array, offset);
+        return;
+    }
+    int mode = READWRITE;
+    int localStatus = 0;
+    fits_file_mode(reinterpret_cast<fitsfile *>(fptr), &mode, &localStatus);
+    long tileDims[MAX_COMPRESS_DIM] = {};
+    fits_get_tile_dim(reinterpret_cast<fitsfile *>(fptr), MAX_COMPRESS_DIM, tileDims, &localStatus);
+    if (localStatus != 0 || mode != READONLY) {
+        fits_clear_errmsg();
+        readImage(array, offset);
+        return;
+    }
+    long const tileHeight = std::max(tileDims[1], 1L);
+    int const firstTileRow = offset[0] / tileHeight;
+    int const nTileRows = (offset[0] + height - 1) / tileHeight - firstTileRow + 1;
+    int const nBands = std::min(nThreads, nTileRows);
+    if (nBands <= 1) {
+        readImage(array, offset);
+        return;
+    }
+    FileMapping mapping(getFileName());
+    int const hdu = getHdu();
+    if (mapping.isValid()) {
+        // Check that the mapped bytes really are this FITS file (they aren't if it is e.g. gzipped).
+        int checkStatus = 0;
+        fitsfile *check = mapping.open(hdu, &checkStatus);
+        bool const usable = (checkStatus == 0) && fits_is_compressed_image(check, &checkStatus);
+        if (check != nullptr) {
+            int closeStatus = 0;
+            fits_close_file(check, &closeStatus);
+        }
+        if (!usable || checkStatus != 0) {
+            fits_clear_errmsg();
+            readImage(array, offset);
+            return;
+        }
+    } else {
+        readImage(array, offset);
+        return;
+    }
+    // Divide the rows into bands that start on tile-row boundaries, one band per thread.
+    std::vector<int> bandStart(nBands + 1, height);
+    for (int i = 0; i < nBands; ++i) {
+        int const tileRow = firstTileRow + (nTileRows * i) / nBands;
+        bandStart[i] = std::max(0, static_cast<int>(tileRow * tileHeight) - offset[0]);
+    }
+    std::vector<int> statuses(nBands, 0);
+    std::vector<std::thread> threads;
+    threads.reserve(nBands);
+    for (int i = 0; i < nBands; ++i) {
+        threads.emplace_back([&, i]() {
+            // first FITS pixel is 1, not 0; the end pixel is inclusive
+            long begin[2] = {offset[1] + 1L, offset[0] + bandStart[i] + 1L};
+            long end[2] = {offset[1] + static_cast<long>(width),
+                           offset[0] + static_cast<long>(bandStart[i + 1])};
+            T *data = array.getData() + static_cast<std::size_t>(bandStart[i]) * width;
+            statuses[i] = readMappedImageBand(mapping, hdu, data, begin, end);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int bandStatus : statuses) {
+        if (bandStatus != 0) {
+            status = bandStatus;
+            if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Reading tile-compressed image");
+            return;
+        }
+    }
+}
+
+bool Fits::isCompressedImage() {
+    bool isCompressed = fits_is_compressed_image(reinterpret_cast<fitsfile *>(fptr), &status);
+    if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Checking compression");
+    return isCompressed;
+}
+
 int Fits::getImageDim() {
     int nAxis = 0;
     fits_get_img_dim(reinterpret_cast<fitsfile *>(fptr), &nAxis, &status);
@@ -1547,6 +1709,28 @@ void setAllowImageCompression(bool allow) { allowImageCompression = allow; }
 
 bool getAllowImageCompression() { return allowImageCompression; }
 
+void setImageReadThreads(int nThreads) {
+    if (nThreads < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of image read threads must be positive, not %d") % nThreads)
+                                  .str());
+    }
+    imageReadThreads = nThreads;
+}
+
+int getImageReadThreads() { return imageReadThreads; }
+
+void setImageWriteThreads(int nThreads) {
+    if (nThreads < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of image write threads must be positive, not %d") % nThreads)
+                                  .str());
+    }
+    imageWriteThreads = nThreads;
+}
+
+int getImageWriteThreads() { return imageWriteThreads; }
+
 // ---- Manipulating files ----------------------------------------------------------------------------------
 
 Fits::Fits(std::string const &filename, std::string const &mode, int behavior_)
@@ -1625,6 +1809,103 @@ void Fits::closeFile() {
     fptr = nullptr;
 }
 
+namespace {
+
+// HDUs written to an in-memory file by one of the functions passed to writeHdus.
+struct HduBuffer {
+    MemFileManager manager;
+    std::size_t begin = 0;  // offset of the first extension HDU
+    std::size_t end = 0;    // offset just past the last HDU, including its padding
+    int nHdus = 0;
+    std::exception_ptr error;
+};
+
+void writeHduBuffer(HduBuffer &buffer, std::function<void(Fits &)> const &writer) {
+    Fits fits(buffer.manager, "w", Fits::AUTO_CLOSE | Fits::AUTO_CHECK);
+    fits.createEmpty();
+    writer(fits);
+    int const nTotal = fits.countHdus();
+    buffer.nHdus = nTotal - 1;
+    if (buffer.nHdus > 0) {
+        auto fptr = reinterpret_cast<fitsfile *>(fits.fptr);
+        LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+        // Moving away from the last HDU makes cfitsio finish it (END keyword, heap size, padding).
+        fits_movabs_hdu(fptr, 1, nullptr, &fits.status);
+        fits_movabs_hdu(fptr, 2, nullptr, &fits.status);
+        fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &fits.status);
+        buffer.begin = headStart;
+        fits_movabs_hdu(fptr, nTotal, nullptr, &fits.status);
+        fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &fits.status);
+        buffer.end = dataEnd;
+        LSST_FITS_CHECK_STATUS(fits, "Locating HDUs in memory file");
+    }
+    fits.closeFile();  // flushes everything to buffer.manager
+    LSST_FITS_CHECK_STATUS(fits, "Closing memory file");
+}
+
+// Append the HDUs held by `buffer` to the end of `fits`, byte for byte.
+void appendHduBuffer(Fits &fits, HduBuffer const &buffer) {
+    if (buffer.nHdus == 0) return;
+    auto fptr = reinterpret_cast<fitsfile *>(fits.fptr);
+    int const nExisting = fits.countHdus();
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    fits_movabs_hdu(fptr, nExisting, nullptr, &fits.status);
+    fits_set_hdustruc(fptr, &fits.status);  // write the END keyword and padding of the last HDU
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &fits.status);
+    // These are the low-level routines cfitsio itself writes all HDUs with, so its buffering and
+    // notion of the file size stay consistent.
+    ffmbyt(fptr, dataEnd, IGNORE_EOF, &fits.status);
+    ffpbyt(fptr, buffer.end - buffer.begin, static_cast<char *>(buffer.manager.getData()) + buffer.begin,
+           &fits.status);
+    // Let cfitsio read the new headers so it knows where the new HDUs start and end.
+    fits_movabs_hdu(fptr, nExisting + buffer.nHdus, nullptr, &fits.status);
+    if (fits.behavior & Fits::AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(fits, "Appending HDUs written in memory");
+    }
+}
+
+}  // namespace
+
+void writeHdus(Fits &fitsfile, std::vector<std::function<void(Fits &)>> const &writers) {
+    int const nThreads = std::min(getImageWriteThreads(), static_cast<int>(writers.size()));
+    if (nThreads <= 1 || !fits_is_reentrant()) {
+        for (auto const &writer : writers) {
+            writer(fitsfile);
+        }
+        return;
+    }
+    if (fitsfile.countHdus() < 1) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Cannot append extension HDUs to a file with no primary HDU");
+    }
+    std::vector<HduBuffer> buffers(writers.size());
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (int i = 0; i < nThreads; ++i) {
+        threads.emplace_back([&]() {
+            for (std::size_t j = next++; j < writers.size(); j = next++) {
+                try {
+                    writeHduBuffer(buffers[j], writers[j]);
+                } catch (...) {
+                    buffers[j].error = std::current_exception();
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto const &buffer : buffers) {
+        if (buffer.error) {
+            std::rethrow_exception(buffer.error);
+        }
+    }
+    for (auto const &buffer : buffers) {
+        appendHduBuffer(fitsfile, buffer);
+    }
+}
+
 std::shared_ptr<daf::base::PropertyList> combineMetadata(
         std::shared_ptr<const daf::base::PropertyList> first,
         std::shared_ptr<const daf::base::PropertyList> second) {
@@ -1760,7 +2041,8 @@ ImageWriteOptions::ImageWriteOptions(daf::base::PropertySet const &config)
                                                       : std::vector<std::string>{},
                   config.getAsInt("scaling.seed"), config.getAsDouble("scaling.quantizeLevel"),
                   config.getAsDouble("scaling.quantizePad"), config.get<bool>("scaling.fuzz"),
-                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero")) {}
+                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero"),
+                  config.exists("scaling.statsSamples") ? config.getAsInt64("scaling.statsSamples") : 0) {}
 
 namespace {
 
@@ -1795,6 +2077,7 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
     validateEntry(*validated, config, "scaling.fuzz", true);
     validateEntry(*validated, config, "scaling.bscale", 1.0);
     validateEntry(*validated, config, "scaling.bzero", 0.0);
+    validateEntry(*validated, config, "scaling.statsSamples", 0);
 
     // Check for additional entries that we don't support (e.g., from typos)
     for (auto const &name : config.names(false)) {
@@ -1825,6 +2108,8 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
                                    std::shared_ptr<daf::base::PropertySet const>,          \
                                    std::shared_ptr<image::Mask<image::MaskPixel> const>);  \
     template void Fits::readImageImpl(int, T *, long *, long *, long *);                   \
+    template void Fits::readTiledImage(ndarray::Array<T, 2, 2> const &,                    \
+                                       ndarray::Vector<int, 2> const &);                   \
     template bool Fits::checkImageType<T>();                                               \
     template int getBitPix<T>();
 
@@ -1,5 +1,7 @@
 // -*- lsst-c++ -*-
 
+#include <random>
+
 #include "fitsio.h"
 extern "C" {
 #include "fitsio2.h"
@@ -129,7 +131,7 @@ std::string scalingAlgorithmToString(ImageScalingOptions::ScalingAlgorithm algor
 ImageScalingOptions::ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix_,
                                          std::vector<std::string> const& maskPlanes_, int seed_,
                                          float quantizeLevel_, float quantizePad_, bool fuzz_, double bscale_,
-                                         double bzero_)
+                                         double bzero_, std::size_t statsSamples_)
         : algorithm(algorithm_),
           bitpix(bitpix_),
           fuzz(fuzz_),
@@ -139,10 +141,32 @@ ImageScalingOptions::ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix
           quantizeLevel(quantizeLevel_),
           quantizePad(quantizePad_),
           bscale(bscale_),
-          bzero(bzero_) {}
+          bzero(bzero_),
+          statsSamples(statsSamples_) {}
 
 namespace {
 
+/// Calculate median and standard deviation of values, reordering them
+template <typename T>
+std::pair<T, T> calculateMedianStdevInPlace(ndarray::Array<T, 1, 1> const& array) {
+    std::size_t const num = array.getNumElements();
+
+    // Quartiles; from https://stackoverflow.com/a/11965377/834250
+    auto const q1 = num / 4;
+    auto const q2 = num / 2;
+    auto const q3 = q1 + q2;
+    std::nth_element(array.begin(), array.begin() + q1, array.end());
+    std::nth_element(array.begin() + q1 + 1, array.begin() + q2, array.end());
+    std::nth_element(array.begin() + q2 + 1, array.begin() + q3, array.end());
+
+    T const median = num % 2 ? array[num / 2] : 0.5 * (array[num / 2] + array[num / 2 - 1]);
+    // No, we're not doing any interpolation for the lower and upper quartiles.
+    // We're estimating the noise, so it doesn't need to be super precise.
+    T const lq = array[q1];
+    T const uq = array[q3];
+    return std::make_pair(median, 0.741 * (uq - lq));
+}
+
 /// Calculate median and standard deviation for an image
 template <typename T, int N>
 std::pair<T, T> calculateMedianStdev(ndarray::Array<T const, N, N> const& image,
@@ -161,21 +185,33 @@ std::pair<T, T> calculateMedianStdev(ndarray::Array<T const, N, N> const& image,
         *aa = *ii;
         ++aa;
     }
+    return calculateMedianStdevInPlace(array);
+}
 
-    // Quartiles; from https://stackoverflow.com/a/11965377/834250
-    auto const q1 = num / 4;
-    auto const q2 = num / 2;
-    auto const q3 = q1 + q2;
-    std::nth_element(array.begin(), array.begin() + q1, array.end());
-    std::nth_element(array.begin() + q1 + 1, array.begin() + q2, array.end());
-    std::nth_element(array.begin() + q2 + 1, array.begin() + q3, array.end());
-
-    T const median = num % 2 ? array[num / 2] : 0.5 * (array[num / 2] + array[num / 2 - 1]);
-    // No, we're not doing any interpolation for the lower and upper quartiles.
-    // We're estimating the noise, so it doesn't need to be super precise.
-    T const lq = array[q1];
-    T const uq = array[q3];
-    return std::make_pair(median, 0.741 * (uq - lq));
+/// Estimate median and standard deviation for an image from a random sample of its unmasked pixels
+///
+/// Pixels are drawn uniformly, with replacement, from a generator with a fixed seed, so the estimate
+/// is reproducible. If most pixels are masked (so that finding enough unmasked ones takes too many
+/// draws), we calculate the statistics from all unmasked pixels instead.
+template <typename T, int N>
+std::pair<T, T> estimateMedianStdev(ndarray::Array<T const, N, N> const& image,
+                                    ndarray::Array<bool, N, N> const& mask, std::size_t numSamples,
+                                    int seed) {
+    std::size_t const size = image.getNumElements();
+    T const* pixels = image.getData();
+    bool const* masked = mask.getData();
+    std::mt19937_64 rng(seed);
+    ndarray::Array<T, 1, 1> array = ndarray::allocate(numSamples);
+    std::size_t num = 0;
+    for (std::size_t draws = 0; num < numSamples && draws < 4 * numSamples; ++draws) {
+        std::size_t const index = rng() % size;  // bias is negligible for any realistic image size
+        if (masked[index]) continue;
+        array[num++] = pixels[index];
+    }
+    if (num < numSamples) {
+        return calculateMedianStdev(image, mask);
+    }
+    return calculateMedianStdevInPlace(array);
 }
 
 /// Calculate min and max for an image
@@ -232,7 +268,9 @@ template <typename T, int N>
 ImageScale ImageScalingOptions::determineFromStdev(ndarray::Array<T const, N, N> const& image,
                                                    ndarray::Array<bool, N, N> const& mask, bool isUnsigned,
                                                    bool cfitsioPadding) const {
-    auto stats = calculateMedianStdev(image, mask);
+    auto stats = (statsSamples > 0 && statsSamples < image.getNumElements())
+                         ? estimateMedianStdev(image, mask, statsSamples, seed)
+                         : calculateMedianStdev(image, mask);
     auto const median = stats.first, stdev = stats.second;
     double const bscale = static_cast<T>(stdev / quantizeLevel);
 
@@ -21,9 +21,11 @@
  */
 
 #include <algorithm>
+#include <future>
 #include <vector>
 
 #include "Eigen/QR"
+#include "Eigen/SVD"
 #include "lsst/afw/geom/SipApproximation.h"
 #include "lsst/geom/polynomials/PolynomialFunction2d.h"
 
@@ -33,40 +35,96 @@ namespace poly = lsst::geom::polynomials;
 
 namespace {
 
-std::pair<poly::PolynomialFunction2dYX, poly::PolynomialFunction2dYX> fitSipOneDirection(
+// Evaluate all functions of the given basis at all of the given points (one
+// per row), returning a matrix with one row per point and one column per basis
+// function.
+Eigen::MatrixXd makeDesignMatrix(poly::PolynomialBasis2dYX const & basis, Eigen::ArrayX2d const & points) {
+    int const order = basis.getOrder();
+    Eigen::ArrayXXd xPow(points.rows(), order + 1);
+    Eigen::ArrayXXd yPow(points.rows(), order + 1);
+    xPow.col(0).setOnes();
+    yPow.col(0).setOnes();
+    for (int n = 1; n <= order; ++n) {
+        xPow.col(n) = xPow.col(n - 1)*points.col(0);
+        yPow.col(n) = yPow.col(n - 1)*points.col(1);
+    }
+    Eigen::MatrixXd matrix(points.rows(), basis.size());
+    for (auto const & i : basis.getIndices()) {
+        matrix.col(i.flat) = (xPow.col(i.nx)*yPow.col(i.ny)).matrix();
+    }
+    return matrix;
+}
+
+// Apply the (separable, affine) scaling of a ScaledPolynomialBasis2dYX to all
+// of the given points.
+Eigen::ArrayX2d applyScaling(poly::Scaling2d const & scaling, Eigen::ArrayX2d const & points) {
+    auto const origin = scaling.applyForward(lsst::geom::Point2D(0.0, 0.0));
+    auto const unit = scaling.applyForward(lsst::geom::Point2D(1.0, 1.0)) - origin;
+    Eigen::ArrayX2d result(points.rows(), 2);
+    result.col(0) = points.col(0)*unit.getX() + origin.getX();
+    result.col(1) = points.col(1)*unit.getY() + origin.getY();
+    return result;
+}
+
+// Compute the SVD of the design matrix used to fit SIP polynomials in one
+// direction.
+void decomposeSipOneDirection(
     int order,
     lsst::geom::Box2D const & box,
-    double svdThreshold,
-    std::vector<lsst::geom::Point2D> const & input,
-    std::vector<lsst::geom::Point2D> const & output
+    Eigen::ArrayX2d const & input,
+    Eigen::JacobiSVD<Eigen::MatrixXd> & decomp
 ) {
     // The scaled polynomial basis evaluates polynomials after mapping the
     // input coordinates from the given box to [-1, 1]x[-1, 1] (for numerical
     // stability).
     auto basis = poly::ScaledPolynomialBasis2dYX(order, box);
-    auto workspace = basis.makeWorkspace();
-    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(input.size(), basis.size());
-    Eigen::VectorXd xRhs(input.size());
-    Eigen::VectorXd yRhs(input.size());
-    for (int i = 0; i < matrix.rows(); ++i) {
-        basis.fill(input[i], matrix.row(i), workspace);
-        auto rhs = output[i] - input[i];
-        xRhs[i] = rhs.getX();
-        yRhs[i] = rhs.getY();
-    }
+    decomp.compute(
+        makeDesignMatrix(basis.getNested(), applyScaling(basis.getScaling(), input)),
+        Eigen::ComputeThinU | Eigen::ComputeThinV
+    );
+}
+
+std::pair<poly::PolynomialFunction2dYX, poly::PolynomialFunction2dYX> fitSipOneDirection(
+    int order,
+    lsst::geom::Box2D const & box,
+    double svdThreshold,
+    Eigen::JacobiSVD<Eigen::MatrixXd> & decomp,
+    Eigen::ArrayX2d const & input,
+    Eigen::ArrayX2d const & output
+) {
+    auto basis = poly::ScaledPolynomialBasis2dYX(order, box);
     // Since we're not trying to null the zeroth- and first-order terms, the
     // solution is just linear least squares, and we can do that with SVD.
-    auto decomp = matrix.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV);
     if (svdThreshold >= 0) {
         decomp.setThreshold(svdThreshold);
+    } else {
+        decomp.setThreshold(Eigen::Default);
     }
-    auto scaledX = makeFunction2d(basis, decomp.solve(xRhs));
-    auto scaledY = makeFunction2d(basis, decomp.solve(yRhs));
+    Eigen::MatrixX2d solution = decomp.solve((output - input).matrix());
+    auto scaledX = makeFunction2d(basis, Eigen::VectorXd(solution.col(0)));
+    auto scaledY = makeFunction2d(basis, Eigen::VectorXd(solution.col(1)));
     // On return, we simplify the polynomials by moving the remapping transform
     // into the coefficients themselves.
     return std::make_pair(simplified(scaledX), simplified(scaledY));
 }
 
+// Maximum number of grid points for which computeMaxDeviation evaluates the
+// solution at once.
+Eigen::Index const MAX_DEVIATION_BLOCK_SIZE = 1 << 12;
+
+// Evaluate a pair of polynomials with the same basis at all of the given
+// points (one per row).
+Eigen::ArrayX2d evaluatePair(poly::PolynomialFunction2dYX const & fx, poly::PolynomialFunction2dYX const & fy,
+                             Eigen::ArrayX2d const & points) {
+    auto const & basis = fx.getBasis();
+    Eigen::MatrixX2d coefficients(basis.size(), 2);
+    for (std::size_t k = 0; k < basis.size(); ++k) {
+        coefficients(k, 0) = fx[k];
+        coefficients(k, 1) = fy[k];
+    }
+    return (makeDesignMatrix(basis, points)*coefficients).array();
+}
+
 // Return a vector of points on a grid, covering the given bounding box.
 std::vector<lsst::geom::Point2D> makeGrid(lsst::geom::Box2D const & bbox,
                                           lsst::geom::Extent2I const & shape) {
@@ -89,6 +147,18 @@ std::vector<lsst::geom::Point2D> makeGrid(lsst::geom::Box2D const & bbox,
     return points;
 }
 
+// Copy a vector of points into an array with one point per row, subtracting
+// the given offset.
+Eigen::ArrayX2d makePointArray(std::vector<lsst::geom::Point2D> const & points,
+                               lsst::geom::Extent2D const & offset) {
+    Eigen::ArrayX2d result(points.size(), 2);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        result(i, 0) = points[i].getX() - offset.getX();
+        result(i, 1) = points[i].getY() - offset.getY();
+    }
+    return result;
+}
+
 // Make a polynomial object (with packed coefficients) from a square coefficients matrix.
 poly::PolynomialFunction2dYX makePolynomialFromCoeffMatrix(ndarray::Array<double const, 2> const & coeffs) {
     LSST_THROW_IF_NE(coeffs.getSize<0>(), coeffs.getSize<1>(), pex::exceptions::InvalidParameterError,
@@ -110,16 +180,26 @@ struct SipApproximation::Grid {
     // Set up the grid.
     Grid(lsst::geom::Extent2I const & shape_, SipApproximation const & parent);
 
+    // Compute (or reuse, if the order has not changed) the decompositions of the
+    // forward and reverse design matrices.
+    void decompose(int order_);
+
     lsst::geom::Extent2I const shape;  //  number of grid points in each dimension
-    std::vector<lsst::geom::Point2D> dpix1; //  [pixel coords] - CRPIX
-    std::vector<lsst::geom::Point2D> siwc;  //  CD^{-1}([intermediate world coords])
-    std::vector<lsst::geom::Point2D> dpix2; //  round-tripped version of dpix1 if useInverse, or exactly dpix1
+    Eigen::ArrayX2d dpix1; //  [pixel coords] - CRPIX, one point per row
+    Eigen::ArrayX2d siwc;  //  CD^{-1}([intermediate world coords])
+    Eigen::ArrayX2d dpix2; //  round-tripped version of dpix1 if useInverse, or exactly dpix1
+    lsst::geom::Box2D boxFwd;  //  bounding box of dpix1
+    lsst::geom::Box2D boxInv;  //  bounding box of siwc
+
+    int order = -1;  //  order of the cached decompositions, or -1 if there are none
+    Eigen::JacobiSVD<Eigen::MatrixXd> svdFwd;
+    Eigen::JacobiSVD<Eigen::MatrixXd> svdInv;
 };
 
 // Private implementation object for SipApproximation that manages the solution
 struct SipApproximation::Solution {
 
-    static std::unique_ptr<Solution> fit(int order_, double svdThreshold, SipApproximation const & parent);
+    static std::unique_ptr<Solution> fit(int order_, double svdThreshold, Grid & grid);
 
     Solution(poly::PolynomialFunction2dYX const & a_,
              poly::PolynomialFunction2dYX const & b_,
@@ -150,6 +230,14 @@ struct SipApproximation::Solution {
         return siwc + lsst::geom::Extent2D(ap(siwc, ws), bp(siwc, ws));
     }
 
+    Eigen::ArrayX2d applyForward(Eigen::ArrayX2d const & dpix) const {
+        return dpix + evaluatePair(a, b, dpix);
+    }
+
+    Eigen::ArrayX2d applyInverse(Eigen::ArrayX2d const & siwc) const {
+        return siwc + evaluatePair(ap, bp, siwc);
+    }
+
     poly::PolynomialFunction2dYX a;
     poly::PolynomialFunction2dYX b;
     poly::PolynomialFunction2dYX ap;
@@ -157,51 +245,63 @@ struct SipApproximation::Solution {
 };
 
 SipApproximation::Grid::Grid(lsst::geom::Extent2I const & shape_, SipApproximation const & parent) :
-    shape(shape_),
-    dpix1(makeGrid(parent._bbox, shape)),
-    siwc(parent._pixelToIwc->applyForward(dpix1))
+    shape(shape_)
 {
-    // Apply the CRPIX offset to make pix1 into dpix1 (in-place)
-    std::for_each(dpix1.begin(), dpix1.end(), [&parent](lsst::geom::Point2D & p){ p -= parent._crpix; });
+    // Evaluate the exact transform on the whole grid with a single call in each direction.
+    auto const pix = makeGrid(parent._bbox, shape);
+    auto const iwc = parent._pixelToIwc->applyForward(pix);
+    dpix1 = makePointArray(pix, parent._crpix);
 
     if (parent._useInverse) {
         // Set from the given inverse of the given pixels-to-iwc transform
-        // Note that at this point, siwc is still just iwc, because the scaling by cdInv is later.
-        dpix2 = parent._pixelToIwc->applyInverse(siwc);
-        // Apply the CRPIX offset to make pix1 into dpix2 (in-place)
-        std::for_each(dpix2.begin(), dpix2.end(), [&parent](lsst::geom::Point2D & p){ p -= parent._crpix; });
+        dpix2 = makePointArray(parent._pixelToIwc->applyInverse(iwc), parent._crpix);
     } else {
         // Just make dpix2 = dpix1, and hence fit to the true inverse of pixels-to-iwc.
         dpix2 = dpix1;
     }
 
-    // Apply the CD^{-1} transform to siwc
-    std::for_each(siwc.begin(), siwc.end(), [&parent](lsst::geom::Point2D & p){ p = parent._cdInv(p); });
+    // Apply the CD^{-1} transform to iwc (one point per row, hence the transpose).
+    siwc = (makePointArray(iwc, lsst::geom::Extent2D(0.0)).matrix()
+            *parent._cdInv.getMatrix().transpose()).array();
+
+    boxFwd = parent._bbox;
+    boxFwd.shift(-parent._crpix);
+    boxInv.include(lsst::geom::Point2D(siwc.col(0).minCoeff(), siwc.col(1).minCoeff()));
+    boxInv.include(lsst::geom::Point2D(siwc.col(0).maxCoeff(), siwc.col(1).maxCoeff()));
+}
+
+void SipApproximation::Grid::decompose(int order_) {
+    if (order_ == order) {
+        return;
+    }
+    order = -1;
+    // The two decompositions dominate the cost of a fit and are independent,
+    // so we compute the reverse one on a second thread.
+    auto inverse = std::async(std::launch::async, [this, order_]() {
+        decomposeSipOneDirection(order_, boxInv, siwc, svdInv);
+    });
+    decomposeSipOneDirection(order_, boxFwd, dpix1, svdFwd);
+    inverse.get();
+    order = order_;
 }
 
 std::unique_ptr<SipApproximation::Solution> SipApproximation::Solution::fit(
     int order,
     double svdThreshold,
-    SipApproximation const & parent
+    Grid & grid
 ) {
     poly::PolynomialBasis2dYX basis(order);
-    if (basis.size() > parent._grid->dpix1.size()) {
+    if (basis.size() > static_cast<std::size_t>(grid.dpix1.rows())) {
         throw LSST_EXCEPT(
             pex::exceptions::LogicError,
             (boost::format("Number of parameters (%d) is larger than number of data points (%d)")
-             % (2*basis.size()) % (2*parent._grid->dpix1.size())).str()
+             % (2*basis.size()) % (2*grid.dpix1.rows())).str()
         );
     }
 
-    lsst::geom::Box2D boxFwd(parent._bbox);
-    boxFwd.shift(-parent._crpix);
-    auto fwd = fitSipOneDirection(order, boxFwd, svdThreshold, parent._grid->dpix1, parent._grid->siwc);
-
-    lsst::geom::Box2D boxInv;
-    for (auto const & point : parent._grid->siwc) {
-        boxInv.include(point);
-    }
-    auto inv = fitSipOneDirection(order, boxInv, svdThreshold, parent._grid->siwc, parent._grid->dpix2);
+    grid.decompose(order);
+    auto fwd = fitSipOneDirection(order, grid.boxFwd, svdThreshold, grid.svdFwd, grid.dpix1, grid.siwc);
+    auto inv = fitSipOneDirection(order, grid.boxInv, svdThreshold, grid.svdInv, grid.siwc, grid.dpix2);
 
     return std::make_unique<Solution>(fwd.first, fwd.second, inv.first, inv.second);
 }
@@ -222,7 +322,7 @@ SipApproximation::SipApproximation(
     _crpix(crpix),
     _cdInv(lsst::geom::LinearTransform(cd).inverted()),
     _grid(new Grid(gridShape, *this)),
-    _solution(Solution::fit(order, svdThreshold, *this))
+    _solution(Solution::fit(order, svdThreshold, *_grid))
 {}
 
 SipApproximation::SipApproximation(
@@ -374,17 +474,22 @@ void SipApproximation::refineGrid(int f) {
 }
 
 void SipApproximation::fit(int order, double svdThreshold) {
-    _solution = Solution::fit(order, svdThreshold, *this);
+    _solution = Solution::fit(order, svdThreshold, *_grid);
 }
 
 std::pair<double, double> SipApproximation::computeMaxDeviation() const noexcept {
+    // Evaluate the grid in blocks of rows, so the design matrices (one column
+    // per basis function) stay small however fine the grid is.
     std::pair<double, double> maxDiff(0.0, 0.0);
-    auto ws = _solution->makeWorkspace();
-    for (std::size_t i = 0; i < _grid->dpix1.size(); ++i) {
-        auto siwc2 = _solution->applyForward(_grid->dpix1[i], ws);
-        auto dpix2 = _solution->applyInverse(_grid->siwc[i], ws);
-        maxDiff.first = std::max(maxDiff.first, (_grid->siwc[i] - siwc2).computeNorm());
-        maxDiff.second = std::max(maxDiff.second, (_grid->dpix2[i] - dpix2).computeNorm());
+    Eigen::Index const nPoints = _grid->dpix1.rows();
+    for (Eigen::Index begin = 0; begin < nPoints; begin += MAX_DEVIATION_BLOCK_SIZE) {
+        Eigen::Index const n = std::min(MAX_DEVIATION_BLOCK_SIZE, nPoints - begin);
+        Eigen::ArrayX2d const siwcDiff =
+                _grid->siwc.middleRows(begin, n) - _solution->applyForward(_grid->dpix1.middleRows(begin, n));
+        Eigen::ArrayX2d const dpixDiff =
+                _grid->dpix2.middleRows(begin, n) - _solution->applyInverse(_grid->siwc.middleRows(begin, n));
+        maxDiff.first = std::max(maxDiff.first, siwcDiff.matrix().rowwise().norm().maxCoeff());
+        maxDiff.second = std::max(maxDiff.second, dpixDiff.matrix().rowwise().norm().maxCoeff());
     }
     return maxDiff;
 }
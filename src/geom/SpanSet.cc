@@ -962,6 +962,28 @@ std::shared_ptr<SpanSet> SpanSet::union_(image::Mask<T> const& other, T bitmask)
     return union_(*spanSetFromMask);
 }
 
+void SpanSet::setMask(image::RunLengthMask& target, image::MaskPixel bitmask) const {
+    target.setSpanSet(*this, bitmask);
+}
+
+void SpanSet::clearMask(image::RunLengthMask& target, image::MaskPixel bitmask) const {
+    target.clearSpanSet(*this, bitmask);
+}
+
+std::shared_ptr<SpanSet> SpanSet::intersect(image::RunLengthMask const& other,
+                                            image::MaskPixel bitmask) const {
+    return intersect(*other.getSpanSet(bitmask));
+}
+
+std::shared_ptr<SpanSet> SpanSet::intersectNot(image::RunLengthMask const& other,
+                                               image::MaskPixel bitmask) const {
+    return intersectNot(*other.getSpanSet(bitmask));
+}
+
+std::shared_ptr<SpanSet> SpanSet::union_(image::RunLengthMask const& other, image::MaskPixel bitmask) const {
+    return union_(*other.getSpanSet(bitmask));
+}
+
 namespace {
 // Singleton helper class that manages the schema and keys for the persistence of SpanSets
 class SpanSetPersistenceHelper {
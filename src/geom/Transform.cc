@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "astshim.h"
+#include "ndarray/eigen.h"
 #include "lsst/afw/formatters/Utils.h"
 #include "lsst/afw/geom/detail/transformUtils.h"
 #include "lsst/afw/geom/Endpoint.h"
@@ -40,11 +41,64 @@ namespace lsst {
 namespace afw {
 namespace geom {
 
+namespace detail {
+namespace {
+// Distance along each axis between the points used to measure a linear mapping: large, so that rounding
+// of the mapping's offset hardly affects the measured matrix
+double const LINEAR_MEASUREMENT_STEP = 1.0e6;
+}  // namespace
+
+std::shared_ptr<LinearMapping const> LinearMapping::measure(ast::Mapping const &mapping, bool forward) {
+    if (!mapping.getIsLinear() || !(forward ? mapping.hasForward() : mapping.hasInverse())) {
+        return nullptr;
+    }
+    int const nIn = forward ? mapping.getNIn() : mapping.getNOut();
+    // Transform the origin, a point along each axis and (to test the result) a point off the axes
+    ndarray::Array<double, 2, 2> points = ndarray::allocate(nIn, nIn + 2);
+    points.deep() = 0.0;
+    for (int j = 0; j < nIn; ++j) {
+        points[j][j + 1] = LINEAR_MEASUREMENT_STEP;
+        points[j][nIn + 1] = LINEAR_MEASUREMENT_STEP * (0.3 + 0.7 * j);
+    }
+    ndarray::Array<double, 2, 2> const transformed =
+            forward ? mapping.applyForward(points) : mapping.applyInverse(points);
+    auto const out = ndarray::asEigenMatrix(transformed);
+    if (!out.allFinite()) {
+        return nullptr;
+    }
+
+    Eigen::VectorXd const offset = out.col(0);
+    Eigen::MatrixXd const matrix =
+            (out.middleCols(1, nIn).colwise() - offset) / LINEAR_MEASUREMENT_STEP;
+    Eigen::VectorXd const predicted = matrix * ndarray::asEigenMatrix(points).col(nIn + 1) + offset;
+    double const scale = out.cwiseAbs().maxCoeff();
+    if ((predicted - out.col(nIn + 1)).cwiseAbs().maxCoeff() > 1.0e-12 * scale) {
+        return nullptr;
+    }
+    return std::shared_ptr<LinearMapping const>(new LinearMapping(matrix, offset));
+}
+
+std::vector<double> LinearMapping::apply(std::vector<double> const &point) const {
+    std::vector<double> result(_offset.size());
+    Eigen::Map<Eigen::VectorXd>(result.data(), result.size()) =
+            _matrix * Eigen::Map<Eigen::VectorXd const>(point.data(), point.size()) + _offset;
+    return result;
+}
+
+ndarray::Array<double, 2, 2> LinearMapping::apply(ndarray::Array<double, 2, 2> const &points) const {
+    ndarray::Array<double, 2, 2> result = ndarray::allocate(_offset.size(), points.getSize<1>());
+    ndarray::asEigenMatrix(result) = (_matrix * ndarray::asEigenMatrix(points)).colwise() + _offset;
+    return result;
+}
+}  // namespace detail
+
 template <class FromEndpoint, class ToEndpoint>
 Transform<FromEndpoint, ToEndpoint>::Transform(ast::Mapping const &mapping, bool simplify)
         : _fromEndpoint(mapping.getNIn()),
           _mapping(simplify ? mapping.simplified() : mapping.copy()),
-          _toEndpoint(mapping.getNOut()) {}
+          _toEndpoint(mapping.getNOut()) {
+    _initializeLinear();
+}
 
 template <typename FromEndpoint, typename ToEndpoint>
 Transform<FromEndpoint, ToEndpoint>::Transform(ast::FrameSet const &frameSet, bool simplify)
@@ -68,17 +122,27 @@ Transform<FromEndpoint, ToEndpoint>::Transform(ast::FrameSet const &frameSet, bo
     frameSetCopy->setBase(baseIndex);
     frameSetCopy->setCurrent(currentIndex);
     _mapping = simplify ? frameSetCopy->getMapping()->simplified() : frameSetCopy->getMapping();
+    _initializeLinear();
 }
 
 template <typename FromEndpoint, typename ToEndpoint>
 Transform<FromEndpoint, ToEndpoint>::Transform(std::shared_ptr<ast::Mapping> mapping)
-        : _fromEndpoint(mapping->getNIn()), _mapping(mapping), _toEndpoint(mapping->getNOut()) {}
+        : _fromEndpoint(mapping->getNIn()), _mapping(mapping), _toEndpoint(mapping->getNOut()) {
+    _initializeLinear();
+}
+
+template <typename FromEndpoint, typename ToEndpoint>
+void Transform<FromEndpoint, ToEndpoint>::_initializeLinear() {
+    _forwardLinear = detail::LinearMapping::measure(*_mapping, true);
+    _inverseLinear = detail::LinearMapping::measure(*_mapping, false);
+}
 
 template <class FromEndpoint, class ToEndpoint>
 typename ToEndpoint::Point Transform<FromEndpoint, ToEndpoint>::applyForward(
         typename FromEndpoint::Point const &point) const {
     auto const rawFromData = _fromEndpoint.dataFromPoint(point);
-    auto rawToData = _mapping->applyForward(rawFromData);
+    auto rawToData =
+            _forwardLinear ? _forwardLinear->apply(rawFromData) : _mapping->applyForward(rawFromData);
     return _toEndpoint.pointFromData(rawToData);
 }
 
@@ -86,7 +150,8 @@ template <class FromEndpoint, class ToEndpoint>
 typename ToEndpoint::Array Transform<FromEndpoint, ToEndpoint>::applyForward(
         typename FromEndpoint::Array const &array) const {
     auto const rawFromData = _fromEndpoint.dataFromArray(array);
-    auto rawToData = _mapping->applyForward(rawFromData);
+    auto rawToData =
+            _forwardLinear ? _forwardLinear->apply(rawFromData) : _mapping->applyForward(rawFromData);
     return _toEndpoint.arrayFromData(rawToData);
 }
 
@@ -94,7 +159,8 @@ template <class FromEndpoint, class ToEndpoint>
 typename FromEndpoint::Point Transform<FromEndpoint, ToEndpoint>::applyInverse(
         typename ToEndpoint::Point const &point) const {
     auto const rawFromData = _toEndpoint.dataFromPoint(point);
-    auto rawToData = _mapping->applyInverse(rawFromData);
+    auto rawToData =
+            _inverseLinear ? _inverseLinear->apply(rawFromData) : _mapping->applyInverse(rawFromData);
     return _fromEndpoint.pointFromData(rawToData);
 }
 
@@ -102,7 +168,8 @@ template <class FromEndpoint, class ToEndpoint>
 typename FromEndpoint::Array Transform<FromEndpoint, ToEndpoint>::applyInverse(
         typename ToEndpoint::Array const &array) const {
     auto const rawFromData = _toEndpoint.dataFromArray(array);
-    auto rawToData = _mapping->applyInverse(rawFromData);
+    auto rawToData =
+            _inverseLinear ? _inverseLinear->apply(rawFromData) : _mapping->applyInverse(rawFromData);
     return _fromEndpoint.arrayFromData(rawToData);
 }
 
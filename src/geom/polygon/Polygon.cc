@@ -118,33 +118,236 @@ void addSubSampledEdge(std::vector<LsstPoint>& vertices,  // Vector of points to
     }
 }
 
-/// @internal Calculate area of overlap between polygon and pixel
-double pixelOverlap(BoostPolygon const& poly, int const x, int const y) {
-    std::vector<BoostPolygon> overlap;  // Overlap between pixel and polygon
-    LsstBox const pixel(lsst::geom::Point2D(static_cast<double>(x) - 0.5, static_cast<double>(y) - 0.5),
-                        lsst::geom::Point2D(static_cast<double>(x) + 0.5, static_cast<double>(y) + 0.5));
-    // Note that the output of boost::geometry::intersection depends
-    // on values down to the precision limit, so minor variations
-    // in poly input can lead to surprisingly large variations in the
-    // output overlap regions and area computation.
-    boost::geometry::intersection(poly, pixel, overlap);
-    double area = 0.0;
-    for (auto const &i : overlap) {
-        double const polyArea = boost::geometry::area(i);
-        area += std::min(polyArea, 1.0);  // remove any rounding error
+/**
+ * @internal Edges of a polygon, indexed by height for fast point-in-polygon tests
+ *
+ * The polygon is divided into horizontal bands at the heights of its vertices.
+ * No vertex lies strictly within a band, so the edges crossing a band can be
+ * listed once, and a point is inside the polygon if an odd number of the edges
+ * crossing its band lie to its right.
+ */
+class EdgeTable {
+public:
+    explicit EdgeTable(BoostPolygon const& poly) {
+        std::vector<std::pair<LsstPoint, LsstPoint>> edges;
+        addRing(poly.outer(), edges);
+        for (auto const& inner : poly.inners()) {
+            addRing(inner, edges);
+        }
+        for (auto const& edge : edges) {
+            _bands.push_back(edge.first.getY());
+        }
+        std::sort(_bands.begin(), _bands.end());
+        _bands.erase(std::unique(_bands.begin(), _bands.end()), _bands.end());
+
+        std::vector<std::vector<Edge>> bandEdges(_bands.size());
+        for (auto const& edge : edges) {
+            double const y0 = edge.first.getY(), y1 = edge.second.getY();
+            if (y0 == y1) {
+                continue;  // horizontal edges never cross a band
+            }
+            Edge const entry = {edge.first.getX(), y0, (edge.second.getX() - edge.first.getX()) / (y1 - y0)};
+            auto const lo = std::lower_bound(_bands.begin(), _bands.end(), std::min(y0, y1));
+            auto const hi = std::lower_bound(lo, _bands.end(), std::max(y0, y1));
+            for (auto band = lo; band != hi; ++band) {
+                bandEdges[band - _bands.begin()].push_back(entry);
+            }
+        }
+        _offsets.reserve(_bands.size() + 1);
+        _offsets.push_back(0);
+        for (auto const& band : bandEdges) {
+            _edges.insert(_edges.end(), band.begin(), band.end());
+            _offsets.push_back(_edges.size());
+        }
     }
-    return area;
-}
 
-/// @internal Set each pixel in a row to the amount of overlap with polygon
-void pixelRowOverlap(std::shared_ptr<lsst::afw::image::Image<float>> const image, BoostPolygon const& poly,
-                     int const xStart, int const xStop, int const y) {
-    int x = xStart;
-    for (lsst::afw::image::Image<float>::x_iterator i = image->x_at(x - image->getX0(), y - image->getY0());
-         x <= xStop; ++i, ++x) {
-        *i = pixelOverlap(poly, x, y);
+    bool contains(double x, double y) const {
+        if (_bands.empty() || !(y >= _bands.front()) || y >= _bands.back()) {
+            return false;
+        }
+        std::size_t const band = std::upper_bound(_bands.begin(), _bands.end(), y) - _bands.begin() - 1;
+        bool inside = false;
+        for (std::size_t i = _offsets[band]; i < _offsets[band + 1]; ++i) {
+            Edge const& edge = _edges[i];
+            if (edge.x0 + (y - edge.y0) * edge.slope > x) {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+private:
+    struct Edge {
+        double x0, y0;  // a point on the edge
+        double slope;   // dx/dy
+    };
+
+    template <typename RingT>
+    static void addRing(RingT const& ring, std::vector<std::pair<LsstPoint, LsstPoint>>& edges) {
+        // Rings are closed: the last vertex repeats the first
+        for (std::size_t i = 1; i < ring.size(); ++i) {
+            edges.emplace_back(ring[i - 1], ring[i]);
+        }
+    }
+
+    std::vector<double> _bands;         // Distinct heights of the vertices, sorted
+    std::vector<std::size_t> _offsets;  // Start of each band's edges in _edges
+    std::vector<Edge> _edges;           // Edges crossing each band
+};
+
+/**
+ * @internal Exact area of overlap between a polygon and the pixels of an image
+ *
+ * Each pixel row is treated as a horizontal slab.  Following the usual
+ * accumulation scheme of font rasterizers, every edge of the polygon, clipped
+ * to a slab, contributes the signed area between itself and the right-hand
+ * end of the slab: the pixels it crosses receive the exact area of the
+ * trapezoid between the edge and their right-hand side, and every pixel
+ * further right receives the full height of the clipped edge.  The latter is
+ * recorded once, as a step in a running sum, so pixels in the interior of the
+ * polygon are filled without any per-pixel geometry.  Summed over a closed
+ * polygon, the contributions to each pixel are the area of the polygon within
+ * it.
+ *
+ * Coordinates are shifted so that pixel (i, j) of the accumulator covers
+ * [i, i+1) x [j, j+1).
+ */
+class CoverageRasterizer {
+public:
+    using Image = lsst::afw::image::Image<float>;
+
+    CoverageRasterizer(BoostPolygon const& poly, lsst::geom::Box2I const& bbox)
+            : _xOffset(bbox.getMinX() - 0.5), _yOffset(bbox.getMinY() - 0.5) {
+        addRing(poly.outer());
+        for (auto const& inner : poly.inners()) {
+            addRing(inner);
+        }
+        std::sort(_edges.begin(), _edges.end(),
+                  [](Edge const& left, Edge const& right) { return left.yLo < right.yLo; });
+
+        // Restrict the work to the pixels touched by the polygon
+        lsst::geom::Box2D bounds;
+        for (auto const& point : poly.outer()) {
+            bounds.include(point);
+        }
+        _colMin = std::max(0, static_cast<int>(std::floor(bounds.getMinX() - _xOffset)));
+        _colMax = std::min(bbox.getWidth() - 1, static_cast<int>(std::floor(bounds.getMaxX() - _xOffset)));
+        _rowMin = std::max(0, static_cast<int>(std::floor(bounds.getMinY() - _yOffset)));
+        _rowMax = std::min(bbox.getHeight() - 1, static_cast<int>(std::floor(bounds.getMaxY() - _yOffset)));
+
+        // Accumulated contributions are positive for clockwise outer rings
+        double doubleArea = 0.0;
+        auto const& outer = poly.outer();
+        for (std::size_t i = 1; i < outer.size(); ++i) {
+            doubleArea += outer[i - 1].getX() * outer[i].getY() - outer[i].getX() * outer[i - 1].getY();
+        }
+        _sign = (doubleArea > 0) ? -1.0 : 1.0;
+    }
+
+    /// Set the pixels of `image` (which must have the bounding box supplied to the constructor)
+    void rasterize(Image& image) {
+        if (_colMin > _colMax || _rowMin > _rowMax) {
+            return;
+        }
+        int const width = _colMax - _colMin + 1;
+        std::vector<double> area(width), cover(width);
+        std::vector<Edge const*> active;
+        auto next = _edges.begin();
+        for (int row = _rowMin; row <= _rowMax; ++row) {
+            double const yBottom = row, yTop = row + 1;
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [yBottom](Edge const* edge) { return edge->yHi <= yBottom; }),
+                         active.end());
+            for (; next != _edges.end() && next->yLo < yTop; ++next) {
+                if (next->yHi > yBottom) {
+                    active.push_back(&*next);
+                }
+            }
+            if (active.empty()) {
+                continue;
+            }
+            std::fill(area.begin(), area.end(), 0.0);
+            std::fill(cover.begin(), cover.end(), 0.0);
+            for (Edge const* edge : active) {
+                double const yLo = std::max(edge->yLo, yBottom), yHi = std::min(edge->yHi, yTop);
+                if (yHi <= yLo) {
+                    continue;
+                }
+                addSegment(area, cover, edge->xAt(yLo), edge->xAt(yHi), edge->direction * (yHi - yLo));
+            }
+            double sum = 0.0;
+            auto pixel = image.x_at(_colMin, row);
+            for (int i = 0; i < width; ++i, ++pixel) {
+                sum += cover[i];
+                *pixel = std::min(std::max(_sign * (area[i] + sum), 0.0), 1.0);
+            }
+        }
+    }
+
+private:
+    struct Edge {
+        double x0, y0;     // a point on the edge
+        double slope;      // dx/dy
+        double yLo, yHi;   // vertical extent
+        double direction;  // +1 for an upward edge, -1 for downward
+
+        double xAt(double y) const { return x0 + (y - y0) * slope; }
+    };
+
+    template <typename RingT>
+    void addRing(RingT const& ring) {
+        // Rings are closed: the last vertex repeats the first
+        for (std::size_t i = 1; i < ring.size(); ++i) {
+            double const x0 = ring[i - 1].getX() - _xOffset, y0 = ring[i - 1].getY() - _yOffset;
+            double const x1 = ring[i].getX() - _xOffset, y1 = ring[i].getY() - _yOffset;
+            if (y0 == y1) {
+                continue;  // horizontal edges bound no area within a slab
+            }
+            _edges.push_back({x0, y0, (x1 - x0) / (y1 - y0), std::min(y0, y1), std::max(y0, y1),
+                              (y1 > y0) ? 1.0 : -1.0});
+        }
+    }
+
+    /// Integral over [c, c + u] of the length of the pixel [c, c + 1) to the right of x
+    static double rightLengthIntegral(double u) {
+        if (u <= 0.0) {
+            return u;
+        }
+        return (u < 1.0) ? u - 0.5 * u * u : 0.5;
+    }
+
+    /// Accumulate an edge segment running between x=xa and x=xb within a slab, with signed height dy
+    void addSegment(std::vector<double>& area, std::vector<double>& cover, double xa, double xb,
+                    double dy) const {
+        int const width = area.size();
+        double const xLo = std::min(xa, xb) - _colMin, xHi = std::max(xa, xb) - _colMin;
+        int const iLo = static_cast<int>(std::floor(xLo)), iHi = static_cast<int>(std::floor(xHi));
+        if (iHi < 0) {
+            cover[0] += dy;  // the whole row lies to the right
+            return;
+        }
+        if (iLo >= width) {
+            return;  // the whole row lies to the left
+        }
+        if (iLo == iHi) {
+            area[iLo] += dy * (iLo + 1 - 0.5 * (xLo + xHi));
+        } else {
+            double const scale = dy / (xHi - xLo);
+            for (int i = std::max(iLo, 0); i <= std::min(iHi, width - 1); ++i) {
+                area[i] += scale * (rightLengthIntegral(xHi - i) - rightLengthIntegral(xLo - i));
+            }
+        }
+        if (iHi + 1 < width) {
+            cover[iHi + 1] += dy;
+        }
     }
-}
+
+    std::vector<Edge> _edges;
+    double _xOffset, _yOffset;  // position of the corner of the image
+    int _colMin, _colMax;       // range of columns touched by the polygon
+    int _rowMin, _rowMax;       // range of rows touched by the polygon
+    double _sign;               // sign to apply to the accumulated area
+};
 
 }  // anonymous namespace
 
@@ -355,6 +558,23 @@ std::size_t Polygon::hash_value() const noexcept {
 
 bool Polygon::contains(LsstPoint const& point) const { return boost::geometry::within(point, _impl->poly); }
 
+ndarray::Array<bool, 1, 1> Polygon::contains(ndarray::Array<double const, 1> const& x,
+                                             ndarray::Array<double const, 1> const& y) const {
+    if (x.getSize<0>() != y.getSize<0>()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Size of x (%d) does not match size of y (%d)") % x.getSize<0>() %
+                           y.getSize<0>())
+                                  .str());
+    }
+    ndarray::Array<bool, 1, 1> result = ndarray::allocate(x.getSize<0>());
+    EdgeTable const table(_impl->poly);
+    auto xIter = x.begin(), yIter = y.begin();
+    for (auto rIter = result.begin(); rIter != result.end(); ++rIter, ++xIter, ++yIter) {
+        *rIter = table.contains(*xIter, *yIter);
+    }
+    return result;
+}
+
 bool Polygon::overlaps(Polygon const& other) const { return _impl->overlaps(other._impl->poly); }
 
 bool Polygon::overlaps(Box const& box) const { return _impl->overlaps(box); }
@@ -448,73 +668,7 @@ std::shared_ptr<afw::image::Image<float>> Polygon::createImage(lsst::geom::Box2I
     std::shared_ptr<Image> image = std::make_shared<Image>(bbox);
     image->setXY0(bbox.getMin());
     *image = 0.0;
-    lsst::geom::Box2D bounds = getBBox();  // Polygon bounds
-    int xMin = std::max(static_cast<int>(bounds.getMinX()), bbox.getMinX());
-    int xMax = std::min(static_cast<int>(::ceil(bounds.getMaxX())), bbox.getMaxX());
-    int yMin = std::max(static_cast<int>(bounds.getMinY()), bbox.getMinY());
-    int yMax = std::min(static_cast<int>(::ceil(bounds.getMaxY())), bbox.getMaxY());
-    for (int y = yMin; y <= yMax; ++y) {
-        double const yPixelMin = (double)y - 0.5, yPixelMax = (double)y + 0.5;
-        BoostPolygon row;  // A polygon of row y
-        boost::geometry::assign(
-                row, LsstBox(lsst::geom::Point2D(xMin, yPixelMin), lsst::geom::Point2D(xMax, yPixelMax)));
-        std::vector<BoostPolygon> intersections;
-        boost::geometry::intersection(_impl->poly, row, intersections);
-
-        if (intersections.size() == 1 && boost::geometry::num_points(intersections[0]) == 5) {
-            // This row is fairly tame, and should have a long run of pixels within the polygon
-            BoostPolygon const& row = intersections[0];
-            std::vector<double> top, bottom;
-            top.reserve(2);
-            bottom.reserve(2);
-            bool failed = false;
-            for (std::vector<Point>::const_iterator i = row.outer().begin(); i != row.outer().end() - 1;
-                 ++i) {
-                double const xCoord = i->getX(), yCoord = i->getY();
-                if (yCoord == yPixelMin) {
-                    bottom.push_back(xCoord);
-                } else if (yCoord == yPixelMax) {
-                    top.push_back(xCoord);
-                } else {
-                    failed = true;
-                    break;
-                }
-            }
-            if (!failed && top.size() == 2 && bottom.size() == 2) {
-                std::sort(top.begin(), top.end());
-                std::sort(bottom.begin(), bottom.end());
-                int const xMin = std::min(top[0], bottom[0]);
-                int const xStart = ::ceil(std::max(top[0], bottom[0])) + 1;
-                int const xStop = std::min(top[1], bottom[1]) - 1;
-                int const xMax = ::ceil(std::max(top[1], bottom[1]));
-                pixelRowOverlap(image, _impl->poly, std::max(xMin, bbox.getMinX()),
-                                std::min(xStart, bbox.getMaxX()), y);
-                int x = xStart;
-                for (Image::x_iterator i = image->x_at(std::max(xStart, bbox.getMinX()) - image->getX0(),
-                                                       y - image->getY0());
-                     x <= std::min(xStop, bbox.getMaxX()); ++i, ++x) {
-                    *i = 1.0;
-                }
-                pixelRowOverlap(image, _impl->poly, std::max(xStop, bbox.getMinX()),
-                                std::min(xMax, bbox.getMaxX()), y);
-                continue;
-            }
-        }
-
-        // Last resort: do each pixel independently...
-        for (auto const &intersection : intersections) {
-            double xMinRow = xMax, xMaxRow = xMin;
-            std::vector<LsstPoint> const vertices = intersection.outer();
-            for (auto const &vertice : vertices) {
-                double const x = vertice.getX();
-                if (x < xMinRow) xMinRow = x;
-                if (x > xMaxRow) xMaxRow = x;
-            }
-
-            pixelRowOverlap(image, _impl->poly, std::max(static_cast<int>(xMinRow), bbox.getMinX()),
-                            std::min(static_cast<int>(::ceil(xMaxRow)), bbox.getMaxX()), y);
-        }
-    }
+    CoverageRasterizer(_impl->poly, bbox).rasterize(*image);
     return image;
 }
 
@@ -470,7 +470,8 @@ private:
         }
         if (_state == ArchiveState::PRESENT) {
             afw::fits::HduMoveGuard guard(*fitsFile, _hdu);
-            _archive = table::io::InputArchive::readFits(*fitsFile);
+            // Data catalogs are only read when a component needs them; fitsFile outlives this object.
+            _archive = table::io::InputArchive::readFitsLazy(*fitsFile);
             _state = ArchiveState::LOADED;
         }
         assert(_state == ArchiveState::LOADED);  // constructor body should guarantee it's not UNKNOWN
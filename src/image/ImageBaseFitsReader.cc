@@ -195,7 +195,7 @@ ndarray::Array<T, 2, 2> ImageBaseFitsReader::readArray(lsst::geom::Box2I const &
     ndarray::Array<T, 2, 2> result = ndarray::allocate(subBBox.getHeight(), subBBox.getWidth());
     ndarray::Vector<int, 2> offset = ndarray::makeVector(subBBox.getMinY() - fullBBox.getMinY(),
                                                          subBBox.getMinX() - fullBBox.getMinX());
-    _fitsFile->readImage(result, offset);
+    _fitsFile->readTiledImage(result, offset);
     return result;
 }
 
@@ -49,7 +49,10 @@ ImagePca<ImageT>::ImagePca(bool constantWeight)
           _dimensions(0, 0),
           _constantWeight(constantWeight),
           _eigenValues(std::vector<double>()),
-          _eigenImages(ImageList()) {}
+          _eigenImages(ImageList()),
+          _incremental(false),
+          _pixels(),
+          _innerProducts() {}
 
 template <typename ImageT>
 ImagePca<ImageT>::ImagePca(ImagePca const&) = default;
@@ -117,6 +120,62 @@ struct SortEvalueDecreasing
         return a.first > b.first;  // N.b. sort on greater
     }
 };
+
+/*
+ * Copy the pixels of an image, row by row, to consecutive elements of an array
+ */
+template <typename ImageT>
+void flattenImage(ImageT const& image, double* out) {
+    for (int y = 0; y != image.getHeight(); ++y) {
+        for (typename ImageT::const_x_iterator ptr = image.row_begin(y), end = image.row_end(y); ptr != end;
+             ++ptr) {
+            *out++ = *ptr;
+        }
+    }
+}
+
+/*
+ * Set the pixels of an image, row by row, from consecutive elements of an array
+ */
+template <typename ImageT>
+void unflattenImage(double const* in, ImageT& image) {
+    for (int y = 0; y != image.getHeight(); ++y) {
+        for (typename ImageT::x_iterator ptr = image.row_begin(y), end = image.row_end(y); ptr != end;
+             ++ptr) {
+            *ptr = static_cast<typename ImageT::Pixel>(*in++);
+        }
+    }
+}
+
+/*
+ * Set the masks and variances of the eigenimages of MaskedImages to what summing the scaled input images
+ * with MaskedImage::scaledPlus would give; there's nothing to do for Images
+ */
+template <typename ImageT>
+void setEigenImageMaskAndVariance(detail::basic_tag const&, typename ImagePca<ImageT>::ImageList const&,
+                                  Eigen::MatrixXd const&, typename ImagePca<ImageT>::ImageList const&) {}
+
+template <typename ImageT>
+void setEigenImageMaskAndVariance(
+        detail::MaskedImage_tag const&, typename ImagePca<ImageT>::ImageList const& imageList,
+        Eigen::MatrixXd const& weights,  // weights(j, i) is the weight of image j in eigenimage i
+        typename ImagePca<ImageT>::ImageList const& eigenImages) {
+    int const nImage = imageList.size();
+    lsst::geom::Extent2I const dimensions = imageList[0]->getDimensions();
+
+    typename ImageT::Mask mask(dimensions);  // OR of all the input masks
+    Eigen::MatrixXd variances(dimensions.getX() * dimensions.getY(), nImage);
+    for (int j = 0; j != nImage; ++j) {
+        mask |= *imageList[j]->getMask();
+        flattenImage(*imageList[j]->getVariance(), variances.col(j).data());
+    }
+
+    Eigen::MatrixXd const eigenVariances = variances * weights.cwiseAbs2();
+    for (std::size_t i = 0; i != eigenImages.size(); ++i) {
+        *eigenImages[i]->getMask() |= mask;
+        unflattenImage(eigenVariances.col(i).data(), *eigenImages[i]->getVariance());
+    }
+}
 }  // namespace
 
 template <typename ImageT>
@@ -139,28 +198,49 @@ void ImagePca<ImageT>::analyze() {
         return;
     }
     /*
-     * Find the eigenvectors/values of the scalar product matrix, R' (Eq. 7.4)
+     * Copy the image planes of any images we haven't seen before into the columns of _pixels, and calculate
+     * the inner products involving them with matrix products (which Eigen blocks for the cache).  As in
+     * innerProduct(), non-finite pixels don't contribute to the inner products.
      */
-    Eigen::MatrixXd R(nImage, nImage);  // residuals' inner products
+    int const nPixel = _dimensions.getX() * _dimensions.getY();
+    int const nOld = _pixels.cols();  // number of images whose inner products we already know
+    int const nNew = nImage - nOld;
 
-    double flux_bar = 0;  // mean of flux for all regions
-    for (int i = 0; i != nImage; ++i) {
-        typename GetImage<ImageT>::type const& im_i = *GetImage<ImageT>::getImage(_imageList[i]);
-        double const flux_i = getFlux(i);
-        flux_bar += flux_i;
+    _pixels.conservativeResize(nPixel, nImage);
+    for (int i = nOld; i != nImage; ++i) {
+        flattenImage(*GetImage<ImageT>::getImage(_imageList[i]), _pixels.col(i).data());
+    }
 
-        for (int j = i; j != nImage; ++j) {
-            typename GetImage<ImageT>::type const& im_j = *GetImage<ImageT>::getImage(_imageList[j]);
-            double const flux_j = getFlux(j);
+    Eigen::MatrixXd finitePixels;  // _pixels with non-finite values set to 0, if there are any
+    if (!_pixels.allFinite()) {
+        finitePixels = _pixels.unaryExpr([](double value) { return std::isfinite(value) ? value : 0.0; });
+    }
+    Eigen::MatrixXd const& pixels = (finitePixels.size() > 0) ? finitePixels : _pixels;
+
+    Eigen::MatrixXd innerProducts(nImage, nImage);
+    innerProducts.topLeftCorner(nOld, nOld) = _innerProducts;
+    innerProducts.topRightCorner(nOld, nNew).noalias() =
+            pixels.leftCols(nOld).transpose() * pixels.rightCols(nNew);
+    innerProducts.bottomLeftCorner(nNew, nOld) = innerProducts.topRightCorner(nOld, nNew).transpose();
+
+    Eigen::MatrixXd newProducts = Eigen::MatrixXd::Zero(nNew, nNew);  // products of the new images
+    newProducts.selfadjointView<Eigen::Lower>().rankUpdate(pixels.rightCols(nNew).transpose());
+    innerProducts.bottomRightCorner(nNew, nNew) = newProducts.selfadjointView<Eigen::Lower>();
+    _innerProducts.swap(innerProducts);
+    /*
+     * Find the eigenvectors/values of the scalar product matrix, R' (Eq. 7.4)
+     */
+    Eigen::VectorXd fluxes(nImage);
+    for (int i = 0; i != nImage; ++i) {
+        fluxes[i] = getFlux(i);
+    }
+    double const flux_bar = fluxes.mean();  // mean of flux for all regions
 
-            double dot = innerProduct(im_i, im_j);
-            if (_constantWeight) {
-                dot /= flux_i * flux_j;
-            }
-            R(i, j) = R(j, i) = dot / nImage;
-        }
+    Eigen::MatrixXd R = _innerProducts / nImage;  // residuals' inner products
+    if (_constantWeight) {
+        Eigen::VectorXd const invFluxes = fluxes.cwiseInverse();
+        R = invFluxes.asDiagonal() * R * invFluxes.asDiagonal();
     }
-    flux_bar /= nImage;
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eVecValues(R);
     Eigen::MatrixXd const& Q = eVecValues.eigenvectors();
     Eigen::VectorXd const& lambda = eVecValues.eigenvalues();
@@ -184,30 +264,46 @@ void ImagePca<ImageT>::analyze() {
         _eigenValues.push_back(lambdaAndIndex[i].first);
     }
     //
-    // Contruct the first ncomp eigenimages in basis
+    // Contruct the first ncomp eigenimages in basis, all at once as a matrix product
     //
     int ncomp = 100;  // number of components to keep
+    if (ncomp > nImage) {
+        ncomp = nImage;
+    }
 
-    _eigenImages.clear();
-    _eigenImages.reserve(ncomp < nImage ? ncomp : nImage);
-
-    for (int i = 0; i < ncomp; ++i) {
-        if (i >= nImage) {
-            continue;
-        }
-
+    Eigen::MatrixXd weights(nImage, ncomp);  // weights(j, i) is the weight of image j in eigenimage i
+    for (int i = 0; i != ncomp; ++i) {
         int const ii = lambdaAndIndex[i].second;  // the index after sorting (backwards) by eigenvalue
+        for (int j = 0; j != nImage; ++j) {
+            weights(j, i) = Q(j, ii) * (_constantWeight ? flux_bar / getFlux(j) : 1);
+        }
+    }
+    Eigen::MatrixXd const eigenPixels = _pixels * weights;
 
+    _eigenImages.clear();
+    _eigenImages.reserve(ncomp);
+    for (int i = 0; i != ncomp; ++i) {
         std::shared_ptr<ImageT> eImage(new ImageT(_dimensions));
         *eImage = static_cast<typename ImageT::Pixel>(0);
-
-        for (int j = 0; j != nImage; ++j) {
-            int const jj = lambdaAndIndex[j].second;  // the index after sorting (backwards) by eigenvalue
-            double const weight = Q(jj, ii) * (_constantWeight ? flux_bar / getFlux(jj) : 1);
-            eImage->scaledPlus(weight, *_imageList[jj]);
-        }
+        unflattenImage(eigenPixels.col(i).data(), *GetImage<ImageT>::getImage(eImage));
         _eigenImages.push_back(eImage);
     }
+    setEigenImageMaskAndVariance<ImageT>(typename ImageT::image_category(), _imageList, weights,
+                                         _eigenImages);
+
+    if (!_incremental) {
+        _pixels.resize(0, 0);
+        _innerProducts.resize(0, 0);
+    }
+}
+
+template <typename ImageT>
+void ImagePca<ImageT>::setIncremental(bool incremental) {
+    _incremental = incremental;
+    if (!_incremental) {
+        _pixels.resize(0, 0);
+        _innerProducts.resize(0, 0);
+    }
 }
 
 namespace {
@@ -384,6 +480,9 @@ double do_updateBadPixels(detail::MaskedImage_tag const&,
 }  // namespace
 template <typename ImageT>
 double ImagePca<ImageT>::updateBadPixels(unsigned long mask, int const ncomp) {
+    // the images may be about to change, so we can't reuse their pixels or inner products
+    _pixels.resize(0, 0);
+    _innerProducts.resize(0, 0);
     return do_updateBadPixels<ImageT>(typename ImageT::image_category(), _imageList, _fluxList, _eigenImages,
                                       mask, ncomp);
 }
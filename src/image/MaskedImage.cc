@@ -516,14 +516,20 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeFits(
     }
     fitsfile.writeMetadata(*header);
 
-    processPlaneMetadata(imageMetadata, header, "IMAGE");
-    _image->writeFits(fitsfile, imageOptions, header, _mask);
-
-    processPlaneMetadata(maskMetadata, header, "MASK");
-    _mask->writeFits(fitsfile, maskOptions, header);
-
-    processPlaneMetadata(varianceMetadata, header, "VARIANCE");
-    _variance->writeFits(fitsfile, varianceOptions, header, _mask);
+    std::shared_ptr<daf::base::PropertySet> imageHeader;
+    processPlaneMetadata(imageMetadata, imageHeader, "IMAGE");
+    std::shared_ptr<daf::base::PropertySet> maskHeader;
+    processPlaneMetadata(maskMetadata, maskHeader, "MASK");
+    std::shared_ptr<daf::base::PropertySet> varianceHeader;
+    processPlaneMetadata(varianceMetadata, varianceHeader, "VARIANCE");
+
+    // The planes are independent, so they may be scaled and compressed concurrently; see fits::writeHdus.
+    fits::writeHdus(fitsfile,
+                    {[&](fits::Fits& fits) { _image->writeFits(fits, imageOptions, imageHeader, _mask); },
+                     [&](fits::Fits& fits) { _mask->writeFits(fits, maskOptions, maskHeader); },
+                     [&](fits::Fits& fits) {
+                         _variance->writeFits(fits, varianceOptions, varianceHeader, _mask);
+                     }});
 }
 
 // private function conformSizes() ensures that the Mask and Variance have the same dimensions
@@ -20,8 +20,11 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
+#include <vector>
 
 #include "lsst/geom/Point.h"
 #include "lsst/afw/image/PhotoCalib.h"
@@ -69,30 +72,6 @@ double toNanojanskyErr(double instFlux, double instFluxErr, double scale, double
     return std::abs(nanojansky) * hypot(instFluxErr / instFlux, scaleErr / scale);
 }
 
-/**
- * Compute the variance of an array of fluxes, for calculations on MaskedImages.
- *
- * MaskedImage stores the variance instead of the standard deviation, so we can skip a sqrt().
- * Usage in calibrateImage() is to compute flux (nJy) directly, so that the calibration scale is
- * implictly `flux/instFlux` (and thus not passed as an argument).
- *
- * @param instFlux[in] The instrumental flux.
- * @param instFluxVar[in] The variance of the instrumental fluxes.
- * @param scaleErr[in] The error on the calibration scale.
- * @param flux[in] The physical fluxes calculated from the instrumental fluxes.
- * @param out[out] The output array to fill with the variance values.
- */
-void toNanojanskyVariance(ndarray::Array<float const, 2, 1> const &instFlux,
-                          ndarray::Array<float const, 2, 1> const &instFluxVar, float scaleErr,
-                          ndarray::Array<float const, 2, 1> const &flux, ndarray::Array<float, 2, 1> out) {
-    auto eigenFlux = ndarray::asEigen<Eigen::ArrayXpr>(flux);
-    auto eigenInstFluxVar = ndarray::asEigen<Eigen::ArrayXpr>(instFluxVar);
-    auto eigenInstFlux = ndarray::asEigen<Eigen::ArrayXpr>(instFlux);
-    auto eigenOut = ndarray::asEigen<Eigen::ArrayXpr>(out);
-    eigenOut = eigenFlux.square() *
-               (eigenInstFluxVar / eigenInstFlux.square() + (scaleErr / eigenFlux * eigenInstFlux).square());
-}
-
 double toMagnitudeErr(double instFlux, double instFluxErr, double scale, double scaleErr) {
     return 2.5 / std::log(10.0) * hypot(instFluxErr / instFlux, scaleErr / scale);
 }
@@ -145,11 +124,15 @@ void PhotoCalib::instFluxToNanojansky(afw::table::SourceCatalog &sourceCatalog,
     auto instFluxErrKey = sourceCatalog.getSchema().find<double>(instFluxField + "_instFluxErr").key;
     auto nanojanskyKey = sourceCatalog.getSchema().find<double>(outField + "_flux").key;
     auto nanojanskyErrKey = sourceCatalog.getSchema().find<double>(outField + "_fluxErr").key;
+    auto calibration = evaluateCatalog(sourceCatalog);
+    int i = 0;
     for (auto &record : sourceCatalog) {
-        auto result = instFluxToNanojansky(record.get(instFluxKey), record.get(instFluxErrKey),
-                                           record.getCentroid());
-        record.set(nanojanskyKey, result.value);
-        record.set(nanojanskyErrKey, result.error);
+        double instFlux = record.get(instFluxKey);
+        double nanojansky = toNanojansky(instFlux, calibration[i]);
+        record.set(nanojanskyKey, nanojansky);
+        record.set(nanojanskyErrKey, toNanojanskyErr(instFlux, record.get(instFluxErrKey), calibration[i],
+                                                     _calibrationErr, nanojansky));
+        ++i;
     }
 }
 
@@ -200,11 +183,14 @@ void PhotoCalib::instFluxToMagnitude(afw::table::SourceCatalog &sourceCatalog,
     auto instFluxErrKey = sourceCatalog.getSchema().find<double>(instFluxField + "_instFluxErr").key;
     auto magKey = sourceCatalog.getSchema().find<double>(outField + "_mag").key;
     auto magErrKey = sourceCatalog.getSchema().find<double>(outField + "_magErr").key;
+    auto calibration = evaluateCatalog(sourceCatalog);
+    int i = 0;
     for (auto &record : sourceCatalog) {
-        auto result = instFluxToMagnitude(record.get(instFluxKey), record.get(instFluxErrKey),
-                                          record.getCentroid());
-        record.set(magKey, result.value);
-        record.set(magErrKey, result.error);
+        double instFlux = record.get(instFluxKey);
+        record.set(magKey, toMagnitude(instFlux, calibration[i]));
+        record.set(magErrKey,
+                   toMagnitudeErr(instFlux, record.get(instFluxErrKey), calibration[i], _calibrationErr));
+        ++i;
     }
 }
 
@@ -261,22 +247,54 @@ MaskedImage<float> PhotoCalib::calibrateImage(MaskedImage<float> const &maskedIm
                                               bool includeScaleUncertainty) const {
     // Deep copy construct, as we're mutiplying in-place.
     auto result = MaskedImage<float>(maskedImage, true);
+    calibrateImageInPlace(result, includeScaleUncertainty);
+    return result;
+}
 
-    if (_isConstant) {
-        *(result.getImage()) *= _calibrationMean;
-    } else {
-        _calibration->multiplyImage(*(result.getImage()), true);  // only in the overlap region
+void PhotoCalib::calibrateImageInPlace(MaskedImage<float> &maskedImage, bool includeScaleUncertainty) const {
+    lsst::geom::Box2I const bbox = maskedImage.getBBox();
+    double const scaleErr = includeScaleUncertainty ? _calibrationErr : 0.0;
+
+    // The calibration is evaluated a row at a time, only where its domain overlaps the image;
+    // elsewhere the pixels keep their instrumental values.
+    lsst::geom::Box2I region;
+    ndarray::Array<double, 1> xx, yy;
+    if (!_isConstant) {
+        region = _calibration->getBBox();
+        region.clip(bbox);
+        if (!region.isEmpty()) {
+            xx = ndarray::allocate(ndarray::makeVector(region.getWidth()));
+            yy = ndarray::allocate(ndarray::makeVector(region.getWidth()));
+            std::iota(xx.begin(), xx.end(), region.getBeginX());
+        }
     }
-    if (includeScaleUncertainty) {
-        toNanojanskyVariance(maskedImage.getImage()->getArray(), maskedImage.getVariance()->getArray(),
-                             _calibrationErr, result.getImage()->getArray(),
-                             result.getVariance()->getArray());
-    } else {
-        toNanojanskyVariance(maskedImage.getImage()->getArray(), maskedImage.getVariance()->getArray(), 0,
-                             result.getImage()->getArray(), result.getVariance()->getArray());
+    std::vector<double> scale(bbox.getWidth(), _isConstant ? _calibrationMean : 1.0);
+
+    for (int row = 0; row < bbox.getHeight(); ++row) {
+        int const y = bbox.getBeginY() + row;
+        if (!region.isEmpty()) {
+            if (y >= region.getBeginY() && y < region.getEndY()) {
+                yy.deep() = y;
+                auto rowScale = _calibration->evaluate(xx, yy);
+                std::copy(rowScale.begin(), rowScale.end(),
+                          scale.begin() + (region.getBeginX() - bbox.getBeginX()));
+            } else {
+                std::fill(scale.begin(), scale.end(), 1.0);
+            }
+        }
+        // Image and variance are updated together; the variance of the calibrated flux is
+        // (scale*instFlux)^2 * ((instFluxErr/instFlux)^2 + (scaleErr/scale)^2), expanded so that it
+        // remains finite for pixels with zero flux.
+        auto imageIter = maskedImage.getImage()->row_begin(row);
+        auto varianceIter = maskedImage.getVariance()->row_begin(row);
+        for (auto scaleIter = scale.begin(); scaleIter != scale.end();
+             ++scaleIter, ++imageIter, ++varianceIter) {
+            double const instFlux = *imageIter;
+            *imageIter = instFlux * (*scaleIter);
+            *varianceIter = (*scaleIter) * (*scaleIter) * (*varianceIter) +
+                            scaleErr * scaleErr * instFlux * instFlux;
+        }
     }
-
-    return result;
 }
 
 afw::table::SourceCatalog PhotoCalib::calibrateCatalog(afw::table::SourceCatalog const &catalog,
@@ -324,7 +342,36 @@ afw::table::SourceCatalog PhotoCalib::calibrateCatalog(afw::table::SourceCatalog
 
     auto calibration = evaluateCatalog(output);
 
-    // fill in the catalog values
+    // fill in the catalog values, a column at a time if the records are contiguous
+    if (!output.empty() && output.isContiguous()) {
+        auto columns = output.getColumnView();
+        std::size_t const size = output.size();
+        for (auto const &key : keys) {
+            ndarray::Array<double, 1> const instFlux = columns[key.instFlux];
+            ndarray::Array<double, 1> const flux = columns[key.flux];
+            ndarray::Array<double, 1> const mag = columns[key.mag];
+            if (key.instFluxErr.isValid()) {
+                ndarray::Array<double, 1> const instFluxErr = columns[key.instFluxErr];
+                ndarray::Array<double, 1> const fluxErr = columns[key.fluxErr];
+                ndarray::Array<double, 1> const magErr = columns[key.magErr];
+                for (std::size_t i = 0; i < size; ++i) {
+                    double nanojansky = toNanojansky(instFlux[i], calibration[i]);
+                    flux[i] = nanojansky;
+                    mag[i] = toMagnitude(instFlux[i], calibration[i]);
+                    fluxErr[i] = toNanojanskyErr(instFlux[i], instFluxErr[i], calibration[i],
+                                                 _calibrationErr, nanojansky);
+                    magErr[i] = toMagnitudeErr(instFlux[i], instFluxErr[i], calibration[i], _calibrationErr);
+                }
+            } else {
+                for (std::size_t i = 0; i < size; ++i) {
+                    flux[i] = toNanojansky(instFlux[i], calibration[i]);
+                    mag[i] = toMagnitude(instFlux[i], calibration[i]);
+                }
+            }
+        }
+        return output;
+    }
+
     int iRec = 0;
     for (auto &rec : output) {
         for (auto &key : keys) {
@@ -541,6 +588,19 @@ ndarray::Array<double, 1> PhotoCalib::evaluateArray(ndarray::Array<double, 1> co
 }
 
 ndarray::Array<double, 1> PhotoCalib::evaluateCatalog(afw::table::SourceCatalog const &sourceCatalog) const {
+    if (_isConstant) {
+        ndarray::Array<double, 1> result = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
+        result.deep() = _calibrationMean;
+        return result;
+    }
+    // Evaluate directly on the centroid columns when we can
+    auto const centroidKey = sourceCatalog.getTable()->getCentroidSlot().getMeasKey();
+    if (centroidKey.isValid() && !sourceCatalog.empty() && sourceCatalog.isContiguous()) {
+        auto columns = sourceCatalog.getColumnView();
+        ndarray::Array<double const, 1> const xx = columns[centroidKey.getX()];
+        ndarray::Array<double const, 1> const yy = columns[centroidKey.getY()];
+        return _calibration->evaluate(xx, yy);
+    }
     ndarray::Array<double, 1> xx = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
     ndarray::Array<double, 1> yy = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
     size_t i = 0;
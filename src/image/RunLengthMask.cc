@@ -0,0 +1,262 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <type_traits>
+#include <vector>
+
+#include "boost/format.hpp"
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/geom/Span.h"
+#include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/image/RunLengthMask.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+namespace {
+
+using Bits = std::make_unsigned_t<MaskPixel>;
+
+// Return a plane, or null if it is empty.
+std::shared_ptr<geom::SpanSet const> nullIfEmpty(std::shared_ptr<geom::SpanSet const> plane) {
+    return (plane && !plane->empty()) ? plane : nullptr;
+}
+
+}  // namespace
+
+// An empty Mask resolves the plane definitions exactly as a Mask of this size would.
+RunLengthMask::RunLengthMask(lsst::geom::Box2I const &bbox, MaskPlaneDict const &planeDefs)
+        : _bbox(bbox), _planeDict(Mask<MaskPixel>(lsst::geom::Box2I(), planeDefs).getMaskPlaneDict()) {}
+
+RunLengthMask::RunLengthMask(Mask<MaskPixel> const &mask)
+        : _bbox(mask.getBBox()), _planeDict(mask.getMaskPlaneDict()) {
+    // Find runs of all planes in a single pass over the pixels, only doing
+    // work where some bit changes value.
+    std::array<std::vector<geom::Span>, N_PLANES> spans;
+    std::array<int, N_PLANES> starts = {};
+    int const x0 = _bbox.getMinX();
+    int const y0 = _bbox.getMinY();
+    int const width = _bbox.getWidth();
+    auto const array = mask.getArray();
+    auto addRuns = [&](Bits ended, int y, int xEnd) {
+        for (int bit = 0; ended != 0; ++bit, ended >>= 1) {
+            if (ended & 1) {
+                spans[bit].emplace_back(y0 + y, x0 + starts[bit], x0 + xEnd - 1);
+            }
+        }
+    };
+    for (int y = 0; y < _bbox.getHeight(); ++y) {
+        MaskPixel const *row = array[y].getData();
+        MaskPixel previous = 0;
+        for (int x = 0; x < width; ++x) {
+            MaskPixel const value = row[x];
+            if (value == previous) {
+                continue;
+            }
+            Bits started = value & ~previous;
+            for (int bit = 0; started != 0; ++bit, started >>= 1) {
+                if (started & 1) {
+                    starts[bit] = x;
+                }
+            }
+            addRuns(previous & ~value, y, x);
+            previous = value;
+        }
+        addRuns(previous, y, width);
+    }
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (!spans[bit].empty()) {
+            // Runs are already sorted and disjoint.
+            _planes[bit] = std::make_shared<geom::SpanSet>(std::move(spans[bit]), false);
+        }
+    }
+}
+
+MaskPixel RunLengthMask::getPlaneBitMask(std::string const &name) const {
+    auto const iter = _planeDict.find(name);
+    if (iter == _planeDict.end()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Invalid mask plane name: %s") % name).str());
+    }
+    return MaskPixel(1) << iter->second;
+}
+
+Mask<MaskPixel> RunLengthMask::toMask() const {
+    Mask<MaskPixel> mask(_bbox, _planeDict);
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (_planes[bit]) {
+            _planes[bit]->setMask(mask, MaskPixel(1) << bit);
+        }
+    }
+    return mask;
+}
+
+MaskPixel RunLengthMask::get(lsst::geom::Point2I const &point) const {
+    MaskPixel value = 0;
+    if (!_bbox.contains(point)) {
+        return value;
+    }
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (_planes[bit] && _planes[bit]->contains(point)) {
+            value |= MaskPixel(1) << bit;
+        }
+    }
+    return value;
+}
+
+bool RunLengthMask::any(MaskPixel bitmask) const { return (getUsedBits() & bitmask) != 0; }
+
+MaskPixel RunLengthMask::getUsedBits() const {
+    MaskPixel bits = 0;
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (_planes[bit]) {
+            bits |= MaskPixel(1) << bit;
+        }
+    }
+    return bits;
+}
+
+std::shared_ptr<geom::SpanSet> RunLengthMask::getSpanSet(MaskPixel bitmask) const {
+    auto result = std::make_shared<geom::SpanSet>();
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (_planes[bit] && (bitmask & (MaskPixel(1) << bit))) {
+            result = result->union_(*_planes[bit]);
+        }
+    }
+    return result;
+}
+
+std::size_t RunLengthMask::getNumSpans() const {
+    std::size_t n = 0;
+    for (auto const &plane : _planes) {
+        if (plane) {
+            n += plane->size();
+        }
+    }
+    return n;
+}
+
+void RunLengthMask::setSpanSet(geom::SpanSet const &spans, MaskPixel bitmask) {
+    if (spans.empty()) {
+        return;
+    }
+    if (!_bbox.contains(spans.getBBox())) {
+        throw LSST_EXCEPT(pex::exceptions::OutOfRangeError,
+                          (boost::format("SpanSet bounding box %s is not contained by mask bounding box %s") %
+                           spans.getBBox() % _bbox)
+                                  .str());
+    }
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (bitmask & (MaskPixel(1) << bit)) {
+            // SpanSets can't be copied, but clipping to a box that contains them makes a copy.
+            _planes[bit] = _planes[bit] ? _planes[bit]->union_(spans) : spans.clippedTo(_bbox);
+        }
+    }
+}
+
+void RunLengthMask::clearSpanSet(geom::SpanSet const &spans, MaskPixel bitmask) {
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (_planes[bit] && (bitmask & (MaskPixel(1) << bit))) {
+            _planes[bit] = nullIfEmpty(_planes[bit]->intersectNot(spans));
+        }
+    }
+}
+
+void RunLengthMask::_checkCompatible(RunLengthMask const &other) const {
+    if (_planeDict != other._planeDict) {
+        throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Mask dictionaries do not match");
+    }
+    if (_bbox != other._bbox) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Masks have different bounding boxes, %s v %s") % _bbox %
+                           other._bbox)
+                                  .str());
+    }
+}
+
+RunLengthMask &RunLengthMask::operator|=(RunLengthMask const &rhs) {
+    _checkCompatible(rhs);
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (!rhs._planes[bit] || _planes[bit] == rhs._planes[bit]) {
+            continue;
+        }
+        _planes[bit] = _planes[bit] ? _planes[bit]->union_(*rhs._planes[bit]) : rhs._planes[bit];
+    }
+    return *this;
+}
+
+RunLengthMask &RunLengthMask::operator&=(RunLengthMask const &rhs) {
+    _checkCompatible(rhs);
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (!_planes[bit] || _planes[bit] == rhs._planes[bit]) {
+            continue;
+        }
+        _planes[bit] = rhs._planes[bit] ? nullIfEmpty(_planes[bit]->intersect(*rhs._planes[bit])) : nullptr;
+    }
+    return *this;
+}
+
+RunLengthMask &RunLengthMask::operator|=(MaskPixel rhs) {
+    if (_bbox.isEmpty()) {
+        return *this;
+    }
+    std::shared_ptr<geom::SpanSet const> full;
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (rhs & (MaskPixel(1) << bit)) {
+            if (!full) {
+                full = std::make_shared<geom::SpanSet>(_bbox);
+            }
+            _planes[bit] = full;
+        }
+    }
+    return *this;
+}
+
+RunLengthMask &RunLengthMask::operator&=(MaskPixel rhs) {
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        if (!(rhs & (MaskPixel(1) << bit))) {
+            _planes[bit] = nullptr;
+        }
+    }
+    return *this;
+}
+
+bool RunLengthMask::operator==(RunLengthMask const &other) const {
+    if (_bbox != other._bbox || _planeDict != other._planeDict) {
+        return false;
+    }
+    for (int bit = 0; bit < N_PLANES; ++bit) {
+        auto const &a = _planes[bit];
+        auto const &b = other._planes[bit];
+        if (a != b && (!a || !b || *a != *b)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
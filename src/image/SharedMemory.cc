@@ -0,0 +1,341 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/SharedMemory.h"
+
+namespace lsst { namespace afw { namespace image {
+
+namespace {
+
+// Kinds of object that may be stored in a block.
+enum class SharedKind : std::uint32_t { IMAGE = 1, MASK = 2, MASKED_IMAGE = 3 };
+
+// One-character codes for pixel types, matching the Python class suffixes.
+template <typename PixelT>
+struct PixelTypeCode;
+template <>
+struct PixelTypeCode<std::uint16_t> {
+    static char get() { return 'U'; }
+};
+template <>
+struct PixelTypeCode<int> {
+    static char get() { return 'I'; }
+};
+template <>
+struct PixelTypeCode<float> {
+    static char get() { return 'F'; }
+};
+template <>
+struct PixelTypeCode<double> {
+    static char get() { return 'D'; }
+};
+template <>
+struct PixelTypeCode<std::uint64_t> {
+    static char get() { return 'L'; }
+};
+
+char const SHARED_MAGIC[8] = {'A', 'F', 'W', 'S', 'H', 'M', 'E', 'M'};
+std::uint32_t const SHARED_VERSION = 1;
+int const MAX_PLANES = 3;
+// Planes start on cache-line boundaries after a page-sized header.
+std::size_t const HEADER_SIZE = 4096;
+std::size_t const PLANE_ALIGN = 64;
+
+struct SharedHeader {
+    char magic[8];
+    std::uint32_t version;
+    SharedKind kind;
+    std::int32_t x0;
+    std::int32_t y0;
+    std::int32_t width;
+    std::int32_t height;
+    std::uint32_t nPlanes;
+    char pixelTypes[MAX_PLANES];
+    std::uint64_t offsets[MAX_PLANES];
+};
+
+static_assert(sizeof(SharedHeader) <= HEADER_SIZE, "SharedHeader does not fit in the reserved space");
+
+bool isShmName(std::string const& name) {
+    return name.size() > 1 && name[0] == '/' && name.find('/', 1) == std::string::npos;
+}
+
+[[noreturn]] void throwErrno(std::string const& what, std::string const& name) {
+    int const err = errno;
+    throw LSST_EXCEPT(pex::exceptions::IoError,
+                      (boost::format("%s '%s': %s") % what % name % std::strerror(err)).str());
+}
+
+// Closes a file descriptor when it goes out of scope; the mapping outlives it.
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : _fd(fd) {}
+    FileDescriptor(FileDescriptor const&) = delete;
+    FileDescriptor& operator=(FileDescriptor const&) = delete;
+    ~FileDescriptor() {
+        if (_fd >= 0) ::close(_fd);
+    }
+    int get() const { return _fd; }
+
+private:
+    int _fd;
+};
+
+//  A memory mapping that is unmapped when the last ndarray (and hence the last image) referring to it
+//  goes away.  Like table::Block, this inherits from ndarray::Manager so it can be handed directly to
+//  ndarray::external and from there to the ImageBase array constructor.
+class SharedBlock : public ndarray::Manager {
+public:
+    using Ptr = boost::intrusive_ptr<SharedBlock>;
+
+    static Ptr create(std::string const& name, std::size_t size) {
+        bool const shm = isShmName(name);
+        FileDescriptor fd(shm ? ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)
+                              : ::open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600));
+        if (fd.get() < 0) {
+            throwErrno("Cannot create shared memory block", name);
+        }
+        void* data = MAP_FAILED;
+        if (::ftruncate(fd.get(), size) == 0) {
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+        }
+        if (data == MAP_FAILED) {
+            int const err = errno;
+            // don't leave a half-made block behind
+            if (shm) {
+                ::shm_unlink(name.c_str());
+            } else {
+                ::unlink(name.c_str());
+            }
+            errno = err;
+            throwErrno("Cannot allocate shared memory block", name);
+        }
+        return Ptr(new SharedBlock(data, size));
+    }
+
+    static Ptr attach(std::string const& name, bool readOnly) {
+        bool const shm = isShmName(name);
+        int const flags = readOnly ? O_RDONLY : O_RDWR;
+        FileDescriptor fd(shm ? ::shm_open(name.c_str(), flags, 0) : ::open(name.c_str(), flags));
+        if (fd.get() < 0) {
+            throwErrno("Cannot open shared memory block", name);
+        }
+        struct stat info;
+        if (::fstat(fd.get(), &info) != 0) {
+            throwErrno("Cannot determine size of shared memory block", name);
+        }
+        std::size_t const size = info.st_size;
+        if (size < HEADER_SIZE) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("'%s' is too small to be a shared image block") % name).str());
+        }
+        // A read-only attachment is mapped privately so that accidental writes (e.g. through a NumPy
+        // view) trigger copy-on-write instead of a segfault or a change visible to other processes.
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, readOnly ? MAP_PRIVATE : MAP_SHARED,
+                            fd.get(), 0);
+        if (data == MAP_FAILED) {
+            throwErrno("Cannot map shared memory block", name);
+        }
+        return Ptr(new SharedBlock(data, size));
+    }
+
+    SharedHeader& getHeader() const { return *reinterpret_cast<SharedHeader*>(_data); }
+
+    std::size_t getSize() const { return _size; }
+
+    template <typename PixelT>
+    ndarray::Array<PixelT, 2, 1> getPlane(int i) {
+        SharedHeader const& header = getHeader();
+        PixelT* data = reinterpret_cast<PixelT*>(reinterpret_cast<char*>(_data) + header.offsets[i]);
+        return ndarray::external(data, ndarray::makeVector(header.height, header.width),
+                                 ndarray::makeVector(header.width, 1), ndarray::Manager::Ptr(this));
+    }
+
+    ~SharedBlock() override { ::munmap(_data, _size); }
+
+private:
+    SharedBlock(void* data, std::size_t size) : _data(data), _size(size) {}
+
+    void* _data;
+    std::size_t _size;
+};
+
+// Create a block holding planes with the given pixel type codes and sizes, and fill in its header.
+SharedBlock::Ptr createBlock(std::string const& name, SharedKind kind, lsst::geom::Box2I const& bbox,
+                             std::vector<std::pair<char, std::size_t>> const& planes) {
+    if (bbox.isEmpty()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError, "Cannot create a shared image with an empty bbox");
+    }
+    std::size_t const nPix = static_cast<std::size_t>(bbox.getWidth()) * bbox.getHeight();
+    std::vector<std::uint64_t> offsets;
+    std::size_t size = HEADER_SIZE;
+    for (auto const& plane : planes) {
+        offsets.push_back(size);
+        size += ((nPix * plane.second + PLANE_ALIGN - 1) / PLANE_ALIGN) * PLANE_ALIGN;
+    }
+    SharedBlock::Ptr block = SharedBlock::create(name, size);
+    SharedHeader& header = block->getHeader();
+    std::memcpy(header.magic, SHARED_MAGIC, sizeof(SHARED_MAGIC));
+    header.version = SHARED_VERSION;
+    header.kind = kind;
+    header.x0 = bbox.getMinX();
+    header.y0 = bbox.getMinY();
+    header.width = bbox.getWidth();
+    header.height = bbox.getHeight();
+    header.nPlanes = planes.size();
+    for (std::size_t i = 0; i < planes.size(); ++i) {
+        header.pixelTypes[i] = planes[i].first;
+        header.offsets[i] = offsets[i];
+    }
+    return block;
+}
+
+// Attach to a block, checking that it holds the kind of object and the pixel types we expect.
+SharedBlock::Ptr attachBlock(std::string const& name, bool readOnly, SharedKind kind,
+                             std::vector<std::pair<char, std::size_t>> const& planes) {
+    SharedBlock::Ptr block = SharedBlock::attach(name, readOnly);
+    SharedHeader const& header = block->getHeader();
+    if (std::memcmp(header.magic, SHARED_MAGIC, sizeof(SHARED_MAGIC)) != 0 ||
+        header.version != SHARED_VERSION) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("'%s' is not a shared image block") % name).str());
+    }
+    if (header.kind != kind || header.nPlanes != planes.size()) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError,
+                          (boost::format("Shared block '%s' does not hold the requested kind of image") %
+                           name).str());
+    }
+    std::size_t const nPix = static_cast<std::size_t>(header.width) * header.height;
+    for (std::size_t i = 0; i < planes.size(); ++i) {
+        if (header.pixelTypes[i] != planes[i].first) {
+            throw LSST_EXCEPT(pex::exceptions::TypeError,
+                              (boost::format("Plane %d of shared block '%s' has pixel type '%c', not '%c'") %
+                               i % name % header.pixelTypes[i] % planes[i].first).str());
+        }
+        if (header.offsets[i] + nPix * planes[i].second > block->getSize()) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Shared block '%s' is truncated") % name).str());
+        }
+    }
+    return block;
+}
+
+lsst::geom::Point2I getXY0(SharedBlock const& block) {
+    return lsst::geom::Point2I(block.getHeader().x0, block.getHeader().y0);
+}
+
+template <typename PixelT>
+std::pair<char, std::size_t> describePlane() {
+    return std::make_pair(PixelTypeCode<PixelT>::get(), sizeof(PixelT));
+}
+
+template <typename ImagePixelT>
+std::vector<std::pair<char, std::size_t>> describeMaskedImage() {
+    return {describePlane<ImagePixelT>(), describePlane<MaskPixel>(), describePlane<VariancePixel>()};
+}
+
+template <typename ImagePixelT>
+MaskedImage<ImagePixelT> makeMaskedImageFromBlock(SharedBlock& block) {
+    lsst::geom::Point2I const xy0 = getXY0(block);
+    return MaskedImage<ImagePixelT>(
+            std::make_shared<Image<ImagePixelT>>(block.getPlane<ImagePixelT>(0), false, xy0),
+            std::make_shared<Mask<MaskPixel>>(block.getPlane<MaskPixel>(1), false, xy0),
+            std::make_shared<Image<VariancePixel>>(block.getPlane<VariancePixel>(2), false, xy0));
+}
+
+}  // namespace
+
+template <typename PixelT>
+Image<PixelT> makeSharedImage(std::string const& name, lsst::geom::Box2I const& bbox) {
+    auto block = createBlock(name, SharedKind::IMAGE, bbox, {describePlane<PixelT>()});
+    return Image<PixelT>(block->getPlane<PixelT>(0), false, getXY0(*block));
+}
+
+template <typename PixelT>
+Image<PixelT> attachSharedImage(std::string const& name, bool readOnly) {
+    auto block = attachBlock(name, readOnly, SharedKind::IMAGE, {describePlane<PixelT>()});
+    return Image<PixelT>(block->getPlane<PixelT>(0), false, getXY0(*block));
+}
+
+Mask<MaskPixel> makeSharedMask(std::string const& name, lsst::geom::Box2I const& bbox) {
+    auto block = createBlock(name, SharedKind::MASK, bbox, {describePlane<MaskPixel>()});
+    return Mask<MaskPixel>(block->getPlane<MaskPixel>(0), false, getXY0(*block));
+}
+
+Mask<MaskPixel> attachSharedMask(std::string const& name, bool readOnly) {
+    auto block = attachBlock(name, readOnly, SharedKind::MASK, {describePlane<MaskPixel>()});
+    return Mask<MaskPixel>(block->getPlane<MaskPixel>(0), false, getXY0(*block));
+}
+
+template <typename ImagePixelT>
+MaskedImage<ImagePixelT> makeSharedMaskedImage(std::string const& name, lsst::geom::Box2I const& bbox) {
+    auto block = createBlock(name, SharedKind::MASKED_IMAGE, bbox, describeMaskedImage<ImagePixelT>());
+    return makeMaskedImageFromBlock<ImagePixelT>(*block);
+}
+
+template <typename ImagePixelT>
+MaskedImage<ImagePixelT> attachSharedMaskedImage(std::string const& name, bool readOnly) {
+    auto block = attachBlock(name, readOnly, SharedKind::MASKED_IMAGE, describeMaskedImage<ImagePixelT>());
+    return makeMaskedImageFromBlock<ImagePixelT>(*block);
+}
+
+void unlinkSharedMemory(std::string const& name) {
+    int const status = isShmName(name) ? ::shm_unlink(name.c_str()) : ::unlink(name.c_str());
+    if (status != 0) {
+        throwErrno("Cannot unlink shared memory block", name);
+    }
+}
+
+//
+// Explicit instantiations
+//
+/// @cond
+#define INSTANTIATE(T)                                                                                    \
+    template Image<T> makeSharedImage(std::string const&, lsst::geom::Box2I const&);                      \
+    template Image<T> attachSharedImage(std::string const&, bool);                                        \
+    template MaskedImage<T> makeSharedMaskedImage(std::string const&, lsst::geom::Box2I const&);          \
+    template MaskedImage<T> attachSharedMaskedImage(std::string const&, bool)
+
+INSTANTIATE(std::uint16_t);
+INSTANTIATE(int);
+INSTANTIATE(float);
+INSTANTIATE(double);
+INSTANTIATE(std::uint64_t);
+/// @endcond
+
+}}}  // namespace lsst::afw::image
@@ -22,6 +22,7 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
 #include <numeric>
 
 #include "lsst/pex/exceptions.h"
@@ -46,6 +47,18 @@ ndarray::Array<double, 1, 1> BoundedField::evaluate(ndarray::Array<double const,
     return out;
 }
 
+ndarray::Array<double, 2, 2> BoundedField::evaluateGrid(ndarray::Array<double const, 1> const &x,
+                                                        ndarray::Array<double const, 1> const &y) const {
+    int const nx = x.getSize<0>(), ny = y.getSize<0>();
+    ndarray::Array<double, 2, 2> out = ndarray::allocate(ny, nx);
+    ndarray::Array<double, 1, 1> yy = ndarray::allocate(nx);
+    for (int i = 0; i < ny; ++i) {
+        yy.deep() = y[i];
+        out[i] = evaluate(x, yy);
+    }
+    return out;
+}
+
 double BoundedField::integrate() const { throw LSST_EXCEPT(pex::exceptions::LogicError, "Not Implemented"); }
 
 double BoundedField::mean() const { throw LSST_EXCEPT(pex::exceptions::LogicError, "Not Implemented"); }
@@ -90,11 +103,9 @@ struct Divide {
     }
 };
 
-// Helper class to do bilinear interpolation with no dynamic memory
-// allocation. This means we evaluate the function multiple times at some
-// points (when we move to a new interval in y, to be specific). Could
-// probably be optimized for the cases where either step is 1, but that seems
-// premature.
+// Helper class to do bilinear interpolation.  The field is evaluated once, with
+// BoundedField::evaluateGrid, at all the grid points (the cell corners), so no
+// allocation or evaluation happens in the loops over cells.
 class Interpolator {
 public:
     // Description of a cell to interpolate in one dimension.
@@ -103,17 +114,19 @@ public:
         int min;  // lower-bound of cell (coordinate of known value and one before first point to fill in)
         int max;  // upper-bound of cell (coordinate of known value)
         int end;  // upper-bound of cell (one after last point to fill in)
+        int index;  // index of the grid point at min
 
         // Construct from step only.
         //
         // Other variables are initialized (and re-initialized) by calls to reset().
-        explicit Bounds(int step_) : step(step_), min(0), max(0), end(0) {}
+        explicit Bounds(int step_) : step(step_), min(0), max(0), end(0), index(0) {}
 
         // Reset all points (aside from the step) to the first cell in this dimension.
         void reset(int min_) {
             min = min_;
             max = min_ + step;
             end = min_ + step;
+            index = 0;
         }
     };
 
@@ -126,7 +139,10 @@ public:
               _z00(std::numeric_limits<double>::quiet_NaN()),
               _z01(std::numeric_limits<double>::quiet_NaN()),
               _z10(std::numeric_limits<double>::quiet_NaN()),
-              _z11(std::numeric_limits<double>::quiet_NaN()) {}
+              _z11(std::numeric_limits<double>::quiet_NaN()) {
+        _grid = _field->evaluateGrid(makeGridPoints(_region->getBeginX(), _region->getEndX(), xStep),
+                                     makeGridPoints(_region->getBeginY(), _region->getEndY(), yStep));
+    }
 
     // Actually do the interpolation.
     //
@@ -140,6 +156,7 @@ public:
             _y.min = _y.max;
             _y.max += _y.step;
             _y.end = _y.max;
+            ++_y.index;
         }
         {  // special-case last iteration in y
             _y.max = _region->getMaxY();
@@ -149,27 +166,40 @@ public:
     }
 
 private:
+    // Return the grid points in one dimension: every step from begin while they are less than end,
+    // and then the last point (end - 1), which closes the special-case last cell.
+    static ndarray::Array<double, 1, 1> makeGridPoints(int begin, int end, int step) {
+        int const n = (end - begin + step - 1) / step + 1;
+        ndarray::Array<double, 1, 1> points = ndarray::allocate(n);
+        for (int i = 0; i < n - 1; ++i) {
+            points[i] = begin + i * step;
+        }
+        points[n - 1] = end - 1;
+        return points;
+    }
+
     // Process a row of cells, calling _runCell() on each one.
     template <typename T, typename F>
     void _runRow(image::Image<T> &img, F functor) {
         _x.reset(_region->getBeginX());
-        _z00 = _field->evaluate(_x.min, _y.min);
-        _z01 = _field->evaluate(_x.min, _y.max);
+        _z00 = _grid[_y.index][_x.index];
+        _z01 = _grid[_y.index + 1][_x.index];
         while (_x.max < _region->getEndX()) {
-            _z10 = _field->evaluate(_x.max, _y.min);
-            _z11 = _field->evaluate(_x.max, _y.max);
+            _z10 = _grid[_y.index][_x.index + 1];
+            _z11 = _grid[_y.index + 1][_x.index + 1];
             _runCell(img, functor);
             _x.min = _x.max;
             _x.max += _x.step;
             _x.end = _x.max;
+            ++_x.index;
             _z00 = _z10;
             _z01 = _z11;
         }
         {  // special-case last iteration in x
             _x.max = _region->getMaxX();
             _x.end = _region->getEndX();
-            _z10 = _field->evaluate(_x.max, _y.min);
-            _z11 = _field->evaluate(_x.max, _y.max);
+            _z10 = _grid[_y.index][_x.index + 1];
+            _z11 = _grid[_y.index + 1][_x.index + 1];
             _runCell(img, functor);
         }
     }
@@ -216,8 +246,12 @@ private:
     Bounds _x;
     Bounds _y;
     double _z00, _z01, _z10, _z11;
+    ndarray::Array<double, 2, 2> _grid;  // field evaluated at the grid points, indexed [y][x]
 };
 
+// Maximum number of pixels for which applyToImage evaluates the field at once.
+int const MAX_GRID_BLOCK_SIZE = 1 << 16;
+
 template <typename T, typename F>
 void applyToImage(BoundedField const &field, image::Image<T> &img, F functor, bool overlapOnly, int xStep,
                   int yStep) {
@@ -233,18 +267,27 @@ void applyToImage(BoundedField const &field, image::Image<T> &img, F functor, bo
         Interpolator interpolator(&field, &region, xStep, yStep);
         interpolator.run(img, functor);
     } else {
-        // We iterate over rows as a significant optimization for AST-backed bounded fields
-        // (it's also slightly faster for other bounded fields, too).
+        // We evaluate blocks of rows at a time with evaluateGrid: the default implementation
+        // iterates over rows, which is a significant optimization for AST-backed bounded fields,
+        // and some subclasses can share work between rows.  The block size just bounds the
+        // memory used for the evaluated field.
         auto subImage = img.subset(region);
         auto size = region.getWidth();
+        int const blockSize = std::max(1, MAX_GRID_BLOCK_SIZE / size);
         ndarray::Array<double, 1> xx = ndarray::allocate(ndarray::makeVector(size));
-        ndarray::Array<double, 1> yy = ndarray::allocate(ndarray::makeVector(size));
-        // y gets incremented each outer loop, x is always xMin->xMax
+        ndarray::Array<double, 1> yy = ndarray::allocate(ndarray::makeVector(blockSize));
+        // x is always xMin->xMax; we don't need indexToPosition, as we're already working in the
+        // right box (region).
         std::iota(xx.begin(), xx.end(), region.getBeginX());
         auto outRowIter = subImage.getArray().begin();
-        for (int y = region.getBeginY(); y < region.getEndY(); ++y, ++outRowIter) {
-            yy.deep() = y;  // don't need indexToPosition, as we're already working in the right box (region).
-            functor(*outRowIter, field.evaluate(xx, yy));
+        for (int y = region.getBeginY(); y < region.getEndY(); y += blockSize) {
+            int const nRows = std::min(blockSize, region.getEndY() - y);
+            std::iota(yy.begin(), yy.begin() + nRows, y);
+            ndarray::Array<double, 2, 2> block = field.evaluateGrid(xx, yy[ndarray::view(0, nRows)]);
+            for (auto blockRowIter = block.begin(); blockRowIter != block.end();
+                 ++blockRowIter, ++outRowIter) {
+                functor(*outRowIter, *blockRowIter);
+            }
         }
     }
 }
@@ -90,57 +90,82 @@ void evaluateBasis1d(ndarray::Array<double, 1, 1> const& t, double x) {
     }
 }
 
-// Create a matrix of 2-d Chebyshev functions evaluated at a set of positions, with
-// Chebyshev order along columns and evaluation positions along rows.  We pack the
-// 2-d functions using the TrapezoidalPacker class, because we don't want any columns
-// that correspond to coefficients that should be set to zero.
-ndarray::Array<double, 2, 2> makeMatrix(ndarray::Array<double const, 1> const& x,
-                                        ndarray::Array<double const, 1> const& y,
-                                        lsst::geom::AffineTransform const& toChebyshevRange,
-                                        Packer const& packer, Control const& ctrl) {
+// Number of rows of the design matrix held in memory at once while fitting.
+int const FIT_CHUNK_SIZE = 1024;
+
+// Accumulate the normal equations (A^T A and A^T b) of the linear least squares problem
+// min||Ax-b|| for a fit of 2-d Chebyshev functions, a chunk of points at a time, so the
+// full design matrix (one row per data point) never has to be held in memory.  Each chunk
+// of the design matrix is packed using the TrapezoidalPacker class, because we don't want
+// any columns that correspond to coefficients that should be set to zero, and is added
+// to the normal equations with a (vectorized) rank update.
+class NormalEquationsAccumulator {
+public:
+    explicit NormalEquationsAccumulator(Packer const& packer)
+            : _packer(packer),
+              _fisher(Eigen::MatrixXd::Zero(packer.size, packer.size)),
+              _rhs(Eigen::VectorXd::Zero(packer.size)),
+              _chunk(ndarray::allocate(FIT_CHUNK_SIZE, packer.size)),
+              _data(ndarray::allocate(FIT_CHUNK_SIZE)),
+              _nRows(0) {}
+
+    // Add a data point z with weight w, given the 1-d Chebyshev functions evaluated at its position.
+    // As usual for weighted least squares, both the row of the design matrix and the data point
+    // are multiplied by the weight.
+    void add(ndarray::Array<double const, 1, 1> const& tx, ndarray::Array<double const, 1, 1> const& ty,
+             double z, double w = 1.0) {
+        // this sets a row of the chunk to the packed outer product of tx and ty
+        _packer.pack(_chunk[_nRows], tx, ty);
+        if (w != 1.0) {
+            _chunk[_nRows] *= w;
+        }
+        _data[_nRows] = z * w;
+        if (++_nRows == FIT_CHUNK_SIZE) {
+            flush();
+        }
+    }
+
+    // Solve the normal equations.
+    LeastSquares solve(LeastSquares::Factorization factorization) {
+        flush();
+        Eigen::MatrixXd const fisher = _fisher.selfadjointView<Eigen::Lower>();
+        return LeastSquares::fromNormalEquations(fisher, _rhs, factorization);
+    }
+
+private:
+    void flush() {
+        if (_nRows == 0) {
+            return;
+        }
+        auto chunk = ndarray::asEigenMatrix(_chunk);
+        auto data = ndarray::asEigenMatrix(_data);
+        _fisher.selfadjointView<Eigen::Lower>().rankUpdate(chunk.topRows(_nRows).adjoint());
+        _rhs.noalias() += chunk.topRows(_nRows).adjoint() * data.head(_nRows);
+        _nRows = 0;
+    }
+
+    Packer const& _packer;
+    Eigen::MatrixXd _fisher;              // lower triangle of A^T A
+    Eigen::VectorXd _rhs;                 // A^T b
+    ndarray::Array<double, 2, 2> _chunk;  // rows of the design matrix not yet accumulated
+    ndarray::Array<double, 1, 1> _data;   // data values for the rows in _chunk
+    int _nRows;                           // number of rows in _chunk
+};
+
+// Accumulate data points at arbitrary positions, with optional weights.
+void accumulatePoints(NormalEquationsAccumulator& accumulator, ndarray::Array<double const, 1> const& x,
+                      ndarray::Array<double const, 1> const& y, ndarray::Array<double const, 1> const& z,
+                      ndarray::Array<double const, 1> const& w,
+                      lsst::geom::AffineTransform const& toChebyshevRange, Packer const& packer) {
     int const nPoints = x.getSize<0>();
     ndarray::Array<double, 1, 1> tx = ndarray::allocate(packer.nx);
     ndarray::Array<double, 1, 1> ty = ndarray::allocate(packer.ny);
-    ndarray::Array<double, 2, 2> out = ndarray::allocate(nPoints, packer.size);
-    // Loop over x and y together, computing T_i(x) and T_j(y) arrays for each point,
-    // then packing them together.
     for (int p = 0; p < nPoints; ++p) {
         lsst::geom::Point2D sxy = toChebyshevRange(lsst::geom::Point2D(x[p], y[p]));
         evaluateBasis1d(tx, sxy.getX());
         evaluateBasis1d(ty, sxy.getY());
-        packer.pack(out[p], tx, ty);  // this sets a row of out to the packed outer product of tx and ty
+        accumulator.add(tx, ty, z[p], w.isEmpty() ? 1.0 : w[p]);
     }
-    return out;
-}
-
-// Create a matrix of 2-d Chebyshev functions evaluated on a grid of positions, with
-// Chebyshev order along columns and evaluation positions along rows.  We pack the
-// 2-d functions using the TrapezoidalPacker class, because we don't want any columns
-// that correspond to coefficients that should be set to zero.
-ndarray::Array<double, 2, 2> makeMatrix(lsst::geom::Box2I const& bbox,
-                                        lsst::geom::AffineTransform const& toChebyshevRange,
-                                        Packer const& packer, Control const& ctrl) {
-    // Create a 2-d array that contains T_j(x) for each x value, with x values in rows and j in columns
-    ndarray::Array<double, 2, 2> tx = ndarray::allocate(bbox.getWidth(), packer.nx);
-    for (int x = bbox.getBeginX(), p = 0; p < bbox.getWidth(); ++p, ++x) {
-        evaluateBasis1d(tx[p], toChebyshevRange[lsst::geom::AffineTransform::XX] * x +
-                                       toChebyshevRange[lsst::geom::AffineTransform::X]);
-    }
-
-    // Loop over y values, and at each point, compute T_i(y), then loop over x and multiply by the T_j(x)
-    // we already computed and stored above.
-    ndarray::Array<double, 2, 2> out = ndarray::allocate(bbox.getArea(), packer.size);
-    ndarray::Array<double, 2, 2>::Iterator outIter = out.begin();
-    ndarray::Array<double, 1, 1> ty = ndarray::allocate(ctrl.orderY + 1);
-    for (int y = bbox.getBeginY(), i = 0; i < bbox.getHeight(); ++i, ++y) {
-        evaluateBasis1d(ty, toChebyshevRange[lsst::geom::AffineTransform::YY] * y +
-                                    toChebyshevRange[lsst::geom::AffineTransform::Y]);
-        for (int j = 0; j < bbox.getWidth(); ++j, ++outIter) {
-            // this sets a row of out to the packed outer product of tx and ty
-            packer.pack(*outIter, tx[j], ty);
-        }
-    }
-    return out;
 }
 
 }  // namespace
@@ -155,10 +180,12 @@ std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedField::fit(lsst::geom::Bo
     // This packer object knows how to map the 2-d Chebyshev functions onto a 1-d array,
     // using only those that the control says should have nonzero coefficients.
     Packer const packer(ctrl);
-    // Create a "design matrix" for the linear least squares problem (A in min||Ax-b||)
-    ndarray::Array<double, 2, 2> matrix = makeMatrix(x, y, result->_toChebyshevRange, packer, ctrl);
+    // Accumulate the normal equations for the linear least squares problem (A in min||Ax-b||)
+    NormalEquationsAccumulator accumulator(packer);
+    accumulatePoints(accumulator, x, y, z, ndarray::Array<double const, 1>(), result->_toChebyshevRange,
+                     packer);
     // Solve the linear least squares problem.
-    LeastSquares lstsq = LeastSquares::fromDesignMatrix(matrix, z, LeastSquares::NORMAL_EIGENSYSTEM);
+    LeastSquares lstsq = accumulator.solve(LeastSquares::NORMAL_EIGENSYSTEM);
     // Unpack the solution into a 2-d matrix, with zeros for values we didn't fit.
     result->_coefficients = packer.unpack(lstsq.getSolution());
     return result;
@@ -175,15 +202,13 @@ std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedField::fit(lsst::geom::Bo
     // This packer object knows how to map the 2-d Chebyshev functions onto a 1-d array,
     // using only those that the control says should have nonzero coefficients.
     Packer const packer(ctrl);
-    // Create a "design matrix" for the linear least squares problem ('A' in min||Ax-b||)
-    ndarray::Array<double, 2, 2> matrix = makeMatrix(x, y, result->_toChebyshevRange, packer, ctrl);
-    // We want to do weighted least squares, so we multiply both the data vector 'b' and the
-    // matrix 'A' by the weights.
-    ndarray::asEigenArray(matrix).colwise() *= ndarray::asEigenArray(w);
-    ndarray::Array<double, 1, 1> wz = ndarray::copy(z);
-    ndarray::asEigenArray(wz) *= ndarray::asEigenArray(w);
+    // Accumulate the normal equations for the linear least squares problem ('A' in min||Ax-b||);
+    // we want to do weighted least squares, so both the data vector 'b' and the matrix 'A' are
+    // multiplied by the weights.
+    NormalEquationsAccumulator accumulator(packer);
+    accumulatePoints(accumulator, x, y, z, w, result->_toChebyshevRange, packer);
     // Solve the linear least squares problem.
-    LeastSquares lstsq = LeastSquares::fromDesignMatrix(matrix, wz, LeastSquares::NORMAL_EIGENSYSTEM);
+    LeastSquares lstsq = accumulator.solve(LeastSquares::NORMAL_EIGENSYSTEM);
     // Unpack the solution into a 2-d matrix, with zeros for values we didn't fit.
     result->_coefficients = packer.unpack(lstsq.getSolution());
     return result;
@@ -198,13 +223,27 @@ std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedField::fit(image::Image<T
     // This packer object knows how to map the 2-d Chebyshev functions onto a 1-d array,
     // using only those that the control says should have nonzero coefficients.
     Packer const packer(ctrl);
-    ndarray::Array<double, 2, 2> matrix = makeMatrix(bbox, result->_toChebyshevRange, packer, ctrl);
-    // Flatten the data image into a 1-d vector.
-    ndarray::Array<double, 2, 2> imgCopy = ndarray::allocate(img.getArray().getShape());
-    imgCopy.deep() = img.getArray();
-    ndarray::Array<double const, 1, 1> z = ndarray::flatten<1>(imgCopy);
+    lsst::geom::AffineTransform const& toChebyshevRange = result->_toChebyshevRange;
+    // Create a 2-d array that contains T_j(x) for each x value, with x values in rows and j in columns
+    ndarray::Array<double, 2, 2> tx = ndarray::allocate(bbox.getWidth(), packer.nx);
+    for (int x = bbox.getBeginX(), p = 0; p < bbox.getWidth(); ++p, ++x) {
+        evaluateBasis1d(tx[p], toChebyshevRange[lsst::geom::AffineTransform::XX] * x +
+                                       toChebyshevRange[lsst::geom::AffineTransform::X]);
+    }
+    // Loop over y values, and at each point, compute T_i(y), then loop over x and accumulate the
+    // pixels with the T_j(x) we already computed and stored above.
+    NormalEquationsAccumulator accumulator(packer);
+    ndarray::Array<double, 1, 1> ty = ndarray::allocate(packer.ny);
+    for (int y = bbox.getBeginY(), i = 0; i < bbox.getHeight(); ++i, ++y) {
+        evaluateBasis1d(ty, toChebyshevRange[lsst::geom::AffineTransform::YY] * y +
+                                    toChebyshevRange[lsst::geom::AffineTransform::Y]);
+        auto pixel = img.row_begin(i);
+        for (int j = 0; j < bbox.getWidth(); ++j, ++pixel) {
+            accumulator.add(tx[j], ty, *pixel);
+        }
+    }
     // Solve the linear least squares problem.
-    LeastSquares lstsq = LeastSquares::fromDesignMatrix(matrix, z, LeastSquares::NORMAL_EIGENSYSTEM);
+    LeastSquares lstsq = accumulator.solve(LeastSquares::NORMAL_EIGENSYSTEM);
     // Unpack the solution into a 2-d matrix, with zeros for values we didn't fit.
     result->_coefficients = packer.unpack(lstsq.getSolution());
     return result;
@@ -284,6 +323,29 @@ double ChebyshevBoundedField::evaluate(lsst::geom::Point2D const& position) cons
                               _coefficients.getSize<0>());
 }
 
+ndarray::Array<double, 2, 2> ChebyshevBoundedField::evaluateGrid(
+        ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y) const {
+    int const nx = x.getSize<0>(), ny = y.getSize<0>();
+    // Rows of tx and ty hold the 1-d Chebyshev functions evaluated at each column and row position.
+    ndarray::Array<double, 2, 2> tx = ndarray::allocate(nx, _coefficients.getSize<1>());
+    for (int j = 0; j < nx; ++j) {
+        evaluateBasis1d(tx[j], _toChebyshevRange[lsst::geom::AffineTransform::XX] * x[j] +
+                                       _toChebyshevRange[lsst::geom::AffineTransform::X]);
+    }
+    ndarray::Array<double, 2, 2> ty = ndarray::allocate(ny, _coefficients.getSize<0>());
+    for (int i = 0; i < ny; ++i) {
+        evaluateBasis1d(ty[i], _toChebyshevRange[lsst::geom::AffineTransform::YY] * y[i] +
+                                       _toChebyshevRange[lsst::geom::AffineTransform::Y]);
+    }
+    ndarray::Array<double, 2, 2> out = ndarray::allocate(ny, nx);
+    // Sum over the y functions first, giving the coefficients of the x functions for each row;
+    // the image-sized product then has only orderX+1 terms per point.
+    Eigen::MatrixXd const rowCoefficients =
+            ndarray::asEigenMatrix(ty) * ndarray::asEigenMatrix(_coefficients);
+    ndarray::asEigenMatrix(out) = rowCoefficients * ndarray::asEigenMatrix(tx).transpose();
+    return out;
+}
+
 // The integral of T_n(x) over [-1,1]:
 // https://en.wikipedia.org/wiki/Chebyshev_polynomials#Differentiation_and_integration
 double integrateTn(int n) {
@@ -100,6 +100,18 @@ ndarray::Array<double, 1, 1> ProductBoundedField::evaluate(
     return z;
 }
 
+ndarray::Array<double, 2, 2> ProductBoundedField::evaluateGrid(
+    ndarray::Array<double const, 1> const& x,
+    ndarray::Array<double const, 1> const& y
+) const {
+    ndarray::Array<double, 2, 2> z = ndarray::allocate(y.getSize<0>(), x.getSize<0>());
+    z.deep() = 1.0;
+    for (auto const & field : _factors) {
+        ndarray::asEigenArray(z) *= ndarray::asEigenArray(field->evaluateGrid(x, y));
+    }
+    return z;
+}
+
 // ------------------ persistence ---------------------------------------------------------------------------
 
 namespace {
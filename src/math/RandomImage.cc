@@ -25,6 +25,15 @@
 /*
  * Fill Images with Random numbers
  */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/ImageAlgorithm.h"
 #include "lsst/afw/math/Random.h"
@@ -104,6 +113,170 @@ struct do_poisson : public do_random<T> {
 private:
     double const _mu;
 };
+
+/*
+ * The counter-based random numbers for a single pixel
+ *
+ * These are generated by the Philox4x32-10 generator (Salmon et al. 2011, "Parallel random numbers: as
+ * easy as 1, 2, 3") with the seed as its key and a counter made of the pixel's position in the parent
+ * image and the number of blocks already drawn for that pixel, so they depend on nothing else.
+ */
+class PixelRandom {
+public:
+    PixelRandom(std::uint64_t seed, int x, int y)
+            : _key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+              _counter{static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), 0, 0},
+              _block(),
+              _next(4) {}
+
+    /// Uniform in [0, 1)
+    double uniform() {
+        std::uint32_t const hi = nextWord() >> 5;  // 27 bits
+        std::uint32_t const lo = nextWord() >> 6;  // 26 bits
+        return (hi * 67108864.0 + lo) / 9007199254740992.0;
+    }
+
+    /// Uniform in (0, 1)
+    double uniformPos() {
+        std::uint32_t const hi = nextWord() >> 5;
+        std::uint32_t const lo = nextWord() >> 6;
+        return (hi * 67108864.0 + lo + 0.5) / 9007199254740992.0;
+    }
+
+    /// N(0, 1), by the Box-Muller transform
+    double gaussian() {
+        double const r = std::sqrt(-2.0 * std::log(uniformPos()));
+        return r * std::cos(2.0 * M_PI * uniform());
+    }
+
+    /// Gamma(a, 1), by the method of Marsaglia and Tsang (2000)
+    double gamma(double a) {
+        if (a < 1.0) {
+            return gamma(a + 1.0) * std::pow(uniformPos(), 1.0 / a);
+        }
+        double const d = a - 1.0 / 3.0;
+        double const c = 1.0 / std::sqrt(9.0 * d);
+        for (;;) {
+            double const x = gaussian();
+            double v = 1.0 + c * x;
+            if (v <= 0.0) {
+                continue;
+            }
+            v = v * v * v;
+            if (std::log(uniformPos()) < 0.5 * x * x + d - d * v + d * std::log(v)) {
+                return d * v;
+            }
+        }
+    }
+
+    /// Poisson(mu): inversion for small mu, else the PTRS algorithm of Hormann (1993)
+    double poisson(double mu) {
+        if (mu < 10.0) {
+            double p = std::exp(-mu);
+            double cdf = p;
+            double const u = uniform();
+            int k = 0;
+            while (u > cdf && p > 0.0) {
+                ++k;
+                p *= mu / k;
+                cdf += p;
+            }
+            return k;
+        }
+        double const sqrtMu = std::sqrt(mu);
+        double const logMu = std::log(mu);
+        double const b = 0.931 + 2.53 * sqrtMu;
+        double const a = -0.059 + 0.02483 * b;
+        double const invAlpha = 1.1239 + 1.1328 / (b - 3.4);
+        double const vr = 0.9277 - 3.6224 / (b - 2.0);
+        for (;;) {
+            double const u = uniform() - 0.5;
+            double const v = uniform();
+            double const us = 0.5 - std::fabs(u);
+            double const k = std::floor((2.0 * a / us + b) * u + mu + 0.43);
+            if (us >= 0.07 && v <= vr) {
+                return k;
+            }
+            if (k < 0.0 || (us < 0.013 && v > us)) {
+                continue;
+            }
+            if (std::log(v) + std::log(invAlpha) - std::log(a / (us * us) + b) <=
+                -mu + k * logMu - std::lgamma(k + 1.0)) {
+                return k;
+            }
+        }
+    }
+
+private:
+    std::uint32_t nextWord() {
+        if (_next == 4) {
+            philox();
+            ++_counter[2];
+            _next = 0;
+        }
+        return _block[_next++];
+    }
+
+    void philox() {
+        std::uint32_t key[2] = {_key[0], _key[1]};
+        std::uint32_t x[4] = {_counter[0], _counter[1], _counter[2], _counter[3]};
+        for (int round = 0; round != 10; ++round) {
+            if (round > 0) {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            std::uint64_t const p0 = static_cast<std::uint64_t>(0xD2511F53) * x[0];
+            std::uint64_t const p1 = static_cast<std::uint64_t>(0xCD9E8D57) * x[2];
+            std::uint32_t const y[4] = {static_cast<std::uint32_t>(p1 >> 32) ^ x[1] ^ key[0],
+                                        static_cast<std::uint32_t>(p1),
+                                        static_cast<std::uint32_t>(p0 >> 32) ^ x[3] ^ key[1],
+                                        static_cast<std::uint32_t>(p0)};
+            std::copy(y, y + 4, x);
+        }
+        std::copy(x, x + 4, _block);
+    }
+
+    std::uint32_t const _key[2];
+    std::uint32_t _counter[4];
+    std::uint32_t _block[4];  // output of the last call to philox()
+    int _next;                // index of the next unused word in _block
+};
+
+/*
+ * Set every pixel of an image to sample(PixelRandom(seed, x, y)), dividing the rows among nThreads threads
+ */
+template <typename ImageT, typename SampleT>
+void fillCounterBased(ImageT &image, std::uint64_t seed, int nThreads, SampleT const &sample) {
+    if (nThreads < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of threads must be positive, not %d") % nThreads).str());
+    }
+    auto fillRows = [&image, seed, &sample](int yBegin, int yEnd) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            int const parentY = y + image.getY0();
+            int x = image.getX0();
+            for (auto ptr = image.row_begin(y), end = image.row_end(y); ptr != end; ++ptr, ++x) {
+                PixelRandom rand(seed, x, parentY);
+                *ptr = static_cast<typename ImageT::Pixel>(sample(rand));
+            }
+        }
+    };
+
+    int const height = image.getHeight();
+    nThreads = std::min(nThreads, height);
+    if (nThreads <= 1) {
+        fillRows(0, height);
+        return;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (int i = 0; i != nThreads; ++i) {
+        threads.emplace_back(fillRows, (i * height) / nThreads, ((i + 1) * height) / nThreads);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
 }  // namespace
 
 template <typename ImageT>
@@ -141,6 +314,54 @@ void randomPoissonImage(ImageT *image, Random &rand, double const mu) {
     lsst::afw::image::for_each_pixel(*image, do_poisson<typename ImageT::Pixel>(rand, mu));
 }
 
+template <typename ImageT>
+void randomUniformImage(ImageT *image, std::uint64_t seed, int nThreads) {
+    fillCounterBased(*image, seed, nThreads, [](PixelRandom &rand) { return rand.uniform(); });
+}
+
+template <typename ImageT>
+void randomUniformPosImage(ImageT *image, std::uint64_t seed, int nThreads) {
+    fillCounterBased(*image, seed, nThreads, [](PixelRandom &rand) { return rand.uniformPos(); });
+}
+
+template <typename ImageT>
+void randomUniformIntImage(ImageT *image, std::uint64_t seed, unsigned long n, int nThreads) {
+    if (n == 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Upper limit may not be zero");
+    }
+    fillCounterBased(*image, seed, nThreads,
+                     [n](PixelRandom &rand) { return std::min(std::floor(rand.uniform() * n), n - 1.0); });
+}
+
+template <typename ImageT>
+void randomFlatImage(ImageT *image, std::uint64_t seed, double const a, double const b, int nThreads) {
+    fillCounterBased(*image, seed, nThreads,
+                     [a, b](PixelRandom &rand) { return a + (b - a) * rand.uniform(); });
+}
+
+template <typename ImageT>
+void randomGaussianImage(ImageT *image, std::uint64_t seed, int nThreads) {
+    fillCounterBased(*image, seed, nThreads, [](PixelRandom &rand) { return rand.gaussian(); });
+}
+
+template <typename ImageT>
+void randomChisqImage(ImageT *image, std::uint64_t seed, double const nu, int nThreads) {
+    if (!(nu > 0.0)) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Degrees of freedom must be positive, not %g") % nu).str());
+    }
+    fillCounterBased(*image, seed, nThreads, [nu](PixelRandom &rand) { return 2.0 * rand.gamma(0.5 * nu); });
+}
+
+template <typename ImageT>
+void randomPoissonImage(ImageT *image, std::uint64_t seed, double const mu, int nThreads) {
+    if (!(mu >= 0.0)) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Mean must be non-negative, not %g") % mu).str());
+    }
+    fillCounterBased(*image, seed, nThreads, [mu](PixelRandom &rand) { return rand.poisson(mu); });
+}
+
 //
 // Explicit instantiations
 //
@@ -153,7 +374,20 @@ void randomPoissonImage(ImageT *image, Random &rand, double const mu) {
                                   double const b);                                                         \
     template void randomGaussianImage(lsst::afw::image::Image<T> *image, Random &rand);                    \
     template void randomChisqImage(lsst::afw::image::Image<T> *image, Random &rand, double const nu);      \
-    template void randomPoissonImage(lsst::afw::image::Image<T> *image, Random &rand, double const mu);
+    template void randomPoissonImage(lsst::afw::image::Image<T> *image, Random &rand, double const mu);    \
+    template void randomUniformImage(lsst::afw::image::Image<T> *image, std::uint64_t seed, int nThreads); \
+    template void randomUniformPosImage(lsst::afw::image::Image<T> *image, std::uint64_t seed,             \
+                                        int nThreads);                                                     \
+    template void randomUniformIntImage(lsst::afw::image::Image<T> *image, std::uint64_t seed,             \
+                                        unsigned long n, int nThreads);                                    \
+    template void randomFlatImage(lsst::afw::image::Image<T> *image, std::uint64_t seed, double const a,   \
+                                  double const b, int nThreads);                                           \
+    template void randomGaussianImage(lsst::afw::image::Image<T> *image, std::uint64_t seed,               \
+                                      int nThreads);                                                       \
+    template void randomChisqImage(lsst::afw::image::Image<T> *image, std::uint64_t seed, double const nu, \
+                                   int nThreads);                                                          \
+    template void randomPoissonImage(lsst::afw::image::Image<T> *image, std::uint64_t seed,                \
+                                     double const mu, int nThreads);
 
 INSTANTIATE(double)
 INSTANTIATE(float)
@@ -25,6 +25,7 @@
 /*
  * Support statistical operations on images
  */
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <tuple>
@@ -713,6 +714,162 @@ std::shared_ptr<std::vector<typename ImageT::Pixel> > makeVectorCopy(ImageT cons
 
     return imgcp;
 }
+
+/**
+ * @internal Estimate the median and quartiles of the good pixels of an image by histogram refinement
+ *
+ * The six order statistics we interpolate between start out bracketed by [lower, upper).  Each pass over
+ * the pixels histograms the values in each distinct bracket and narrows every bracket to the bin that
+ * holds its rank, so the brackets shrink by a factor of nBins per pass.  A rank is done when its bracket
+ * is no wider than `tolerance` times the standard deviation implied by (a lower bound on) the
+ * interquartile range, and we then interpolate within the final bin.  The pixels are never copied.
+ *
+ * Returns an empty vector if a rank turns out not to lie within its bracket, or if the number of good
+ * pixels isn't `num`; the caller should then fall back to the exact calculation.
+ */
+template <typename IsFinite, typename ImageT, typename MaskT>
+std::vector<double> estimateMedianAndQuartiles(ImageT const &img, MaskT const &msk, int const andMask,
+                                               std::size_t const num, double const lower, double const upper,
+                                               double const tolerance, int const nBins) {
+    int const maxPasses = 8;  // each pass shrinks the brackets by at least a factor of 16
+    double const fractions[] = {0.5, 0.25, 0.75};
+    std::vector<std::size_t> ranks;  // pairs of adjacent ranks to interpolate between
+    for (double const fraction : fractions) {
+        std::size_t const rank = fraction * (num - 1);
+        ranks.push_back(rank);
+        ranks.push_back(std::min(rank + 1, num - 1));
+    }
+    std::size_t const iLowerQuartile = 2;  // lower rank of the lower quartile
+    std::size_t const iUpperQuartile = 5;  // upper rank of the upper quartile
+
+    struct Bracket {
+        double lo, hi;
+        std::size_t below;  // number of good pixels < lo
+        std::vector<std::size_t> histogram;
+    };
+    std::vector<Bracket> brackets = {Bracket{lower, upper, 0, std::vector<std::size_t>(nBins, 0)}};
+    std::vector<std::size_t> which(ranks.size(), 0);  // index of the bracket for each rank
+    std::vector<bool> done(ranks.size(), false);
+    std::vector<double> lo(ranks.size()), width(ranks.size());  // new bracket for each rank
+    std::vector<double> values(ranks.size(), NaN);
+
+    for (int pass = 0; !brackets.empty(); ++pass) {
+        std::size_t nGood = 0;
+        for (int iY = 0; iY < img.getHeight(); ++iY) {
+            typename MaskT::x_iterator mptr = msk.row_begin(iY);
+            for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = img.row_end(iY); ptr != end;
+                 ++ptr, ++mptr) {
+                if (!IsFinite()(*ptr) || (*mptr & andMask)) {
+                    continue;
+                }
+                ++nGood;
+                double const value = *ptr;
+                for (auto &bracket : brackets) {
+                    if (value < bracket.lo) {
+                        ++bracket.below;
+                    } else if (value < bracket.hi) {
+                        int const bin =
+                                static_cast<int>((value - bracket.lo) * nBins / (bracket.hi - bracket.lo));
+                        ++bracket.histogram[std::min(bin, nBins - 1)];
+                    }
+                }
+            }
+        }
+        if (nGood != num) {
+            return std::vector<double>();
+        }
+
+        // Find the bin holding each rank, and the value it has if that bin is its final bracket
+        for (std::size_t ii = 0; ii < ranks.size(); ++ii) {
+            if (done[ii]) {
+                continue;
+            }
+            Bracket const &bracket = brackets[which[ii]];
+            std::size_t cumulative = bracket.below;  // number of good pixels before the current bin
+            if (ranks[ii] < cumulative) {
+                return std::vector<double>();
+            }
+            int bin = 0;
+            for (; bin < nBins && ranks[ii] >= cumulative + bracket.histogram[bin]; ++bin) {
+                cumulative += bracket.histogram[bin];
+            }
+            if (bin == nBins) {
+                return std::vector<double>();
+            }
+            width[ii] = (bracket.hi - bracket.lo) / nBins;
+            lo[ii] = bracket.lo + bin * width[ii];
+            values[ii] = lo[ii] + (ranks[ii] - cumulative + 0.5) / bracket.histogram[bin] * width[ii];
+        }
+
+        double const lowerQuartileMax =
+                done[iLowerQuartile] ? values[iLowerQuartile] : lo[iLowerQuartile] + width[iLowerQuartile];
+        double const upperQuartileMin = done[iUpperQuartile] ? values[iUpperQuartile] : lo[iUpperQuartile];
+        double const resolution = tolerance * IQ_TO_STDEV * (upperQuartileMin - lowerQuartileMax);
+
+        std::vector<Bracket> next;
+        for (std::size_t ii = 0; ii < ranks.size(); ++ii) {
+            if (done[ii]) {
+                continue;
+            }
+            if (width[ii] <= resolution || pass + 1 == maxPasses) {
+                done[ii] = true;
+                continue;
+            }
+            double const newLo = lo[ii];
+            auto const iter = std::find_if(next.begin(), next.end(),
+                                           [newLo](Bracket const &other) { return other.lo == newLo; });
+            which[ii] = iter - next.begin();
+            if (iter == next.end()) {
+                next.push_back(Bracket{newLo, newLo + width[ii], 0, std::vector<std::size_t>(nBins, 0)});
+            }
+        }
+        brackets.swap(next);
+    }
+
+    std::vector<double> quantiles;  // median, lower quartile, upper quartile
+    for (std::size_t ii = 0; ii < 3; ++ii) {
+        double const weight = fractions[ii] * (num - 1) - ranks[2 * ii];
+        quantiles.push_back((1.0 - weight) * values[2 * ii] + weight * values[2 * ii + 1]);
+    }
+    return quantiles;
+}
+
+/**
+ * @internal Estimate the median and quartiles of the good pixels of a floating-point image by histogram
+ * refinement
+ *
+ * Interpolates between adjacent order statistics in the same way as medianAndQuartiles.
+ * Returns an empty vector if the quantiles can't be estimated this way.
+ */
+template <typename ImageT, typename MaskT>
+typename enable_if<!is_integral<typename ImageT::Pixel>::value, std::vector<double> >::type
+estimateMedianAndQuartiles(ImageT const &img, MaskT const &msk, int const andMask, bool const isNanSafe,
+                           std::size_t const num, double const mean, double const stdev,
+                           double const tolerance) {
+    if (num < 2 || !std::isfinite(mean) || !std::isfinite(stdev) || !(stdev > 0)) {
+        return std::vector<double>();
+    }
+    // By Cantelli's inequality the median lies within 1 stdev of the mean and the quartiles within
+    // sqrt(3) stdev; leave some room, as the mean and stdev may be weighted.
+    double const lower = mean - 3 * stdev;
+    double const upper = mean + 3 * stdev;
+    // Enough bins to get to the tolerance in two passes for well-behaved (Gaussian-like) data
+    int const nBins = static_cast<int>(
+            std::max(16.0, std::min(4096.0, std::ceil(std::sqrt((upper - lower) / (tolerance * stdev))))));
+    if (isNanSafe) {
+        return estimateMedianAndQuartiles<ChkFin>(img, msk, andMask, num, lower, upper, tolerance, nBins);
+    } else {
+        return estimateMedianAndQuartiles<AlwaysT>(img, msk, andMask, num, lower, upper, tolerance, nBins);
+    }
+}
+
+/// @internal Integer images have ties to worry about; they always use the exact calculation
+template <typename ImageT, typename MaskT>
+typename enable_if<is_integral<typename ImageT::Pixel>::value, std::vector<double> >::type
+estimateMedianAndQuartiles(ImageT const &, MaskT const &, int const, bool const, std::size_t const,
+                           double const, double const, double const) {
+    return std::vector<double>();
+}
 }  // namespace
 
 double StatisticsControl::getMaskPropagationThreshold(int bit) const {
@@ -875,23 +1032,41 @@ void Statistics::doStatistics(ImageT const &img, MaskT const &msk, VarianceT con
         _nMasked = num - _n;
     }
 
-    // copy the image for any routines that will use median or quantiles
+    // get the median and quartiles for any routines that will use them
     if (flags & (MEDIAN | IQRANGE | MEANCLIP | STDEVCLIP | VARIANCECLIP)) {
-        // make a vector copy of the image to get the median and quartiles (will move values)
-        std::shared_ptr<std::vector<typename ImageT::Pixel> > imgcp;
-        if (_sctrl.getNanSafe()) {
-            imgcp = makeVectorCopy<ChkFin>(img, msk, var, _sctrl.getAndMask());
-        } else {
-            imgcp = makeVectorCopy<AlwaysT>(img, msk, var, _sctrl.getAndMask());
+        bool const medianOnly =
+                (flags & (MEDIAN)) && !(flags & (IQRANGE | MEANCLIP | STDEVCLIP | VARIANCECLIP));
+
+        // median, lower quartile, upper quartile from histograms, if requested and possible
+        std::vector<double> quantiles;
+        if (_sctrl.getQuantileTolerance() > 0) {
+            quantiles = estimateMedianAndQuartiles(img, msk, _sctrl.getAndMask(), _sctrl.getNanSafe(), _n,
+                                                   _mean.first, std::sqrt(_variance.first),
+                                                   _sctrl.getQuantileTolerance());
         }
 
-        // if we *only* want the median, just use percentile(), otherwise use medianAndQuartiles()
-        if ((flags & (MEDIAN)) && !(flags & (IQRANGE | MEANCLIP | STDEVCLIP | VARIANCECLIP))) {
-            _median = Value(percentile(*imgcp, 0.5), NaN);
+        if (!quantiles.empty()) {
+            _median = Value(quantiles[0], NaN);
+            if (!medianOnly) {
+                _iqrange = quantiles[2] - quantiles[1];
+            }
         } else {
-            MedianQuartileReturn mq = medianAndQuartiles(*imgcp);
-            _median = Value(std::get<0>(mq), NaN);
-            _iqrange = std::get<2>(mq) - std::get<1>(mq);
+            // make a vector copy of the image to get the median and quartiles (will move values)
+            std::shared_ptr<std::vector<typename ImageT::Pixel> > imgcp;
+            if (_sctrl.getNanSafe()) {
+                imgcp = makeVectorCopy<ChkFin>(img, msk, var, _sctrl.getAndMask());
+            } else {
+                imgcp = makeVectorCopy<AlwaysT>(img, msk, var, _sctrl.getAndMask());
+            }
+
+            // if we *only* want the median, just use percentile(), otherwise use medianAndQuartiles()
+            if (medianOnly) {
+                _median = Value(percentile(*imgcp, 0.5), NaN);
+            } else {
+                MedianQuartileReturn mq = medianAndQuartiles(*imgcp);
+                _median = Value(std::get<0>(mq), NaN);
+                _iqrange = std::get<2>(mq) - std::get<1>(mq);
+            }
         }
 
         if (flags & (MEANCLIP | STDEVCLIP | VARIANCECLIP)) {
@@ -23,8 +23,12 @@
 /*
  * Bin an Image or MaskedImage by an integral factor (the same in x and y)
  */
+#include <algorithm>
 #include <memory>
 #include <cstdint>
+#include <vector>
+
+#include "ndarray.h"
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/math/offsetImage.h"
@@ -35,6 +39,160 @@ namespace lsst {
 namespace afw {
 namespace math {
 
+namespace {
+/*
+ * Set each pixel of out to the sum of the corresponding binX*binY pixels of in, divided by norm
+ *
+ * Each output row is accumulated in double precision from whole input rows, so that the inner loops run
+ * over contiguous memory.  Sums of integers are exact, and dividing them (rather than multiplying by a
+ * rounded reciprocal) keeps exact quotients exact, so the conversion to OutT truncates as integer
+ * division would.
+ */
+template <typename InT, typename OutT>
+void binArraySum(ndarray::Array<InT, 2, 1> const& in, int const binX, int const binY, double const norm,
+                 ndarray::Array<OutT, 2, 1> const& out) {
+    int const outWidth = out.template getSize<1>();
+    int const outHeight = out.template getSize<0>();
+    int const inWidth = outWidth * binX;  // number of input pixels used in each row
+
+    std::vector<double> rowSum(inWidth);
+    for (int oy = 0; oy != outHeight; ++oy) {
+        std::fill(rowSum.begin(), rowSum.end(), 0.0);
+        for (int iy = oy * binY, iyEnd = iy + binY; iy != iyEnd; ++iy) {
+            InT const* inPtr = in[iy].getData();
+            for (int ix = 0; ix != inWidth; ++ix) {
+                rowSum[ix] += inPtr[ix];
+            }
+        }
+        OutT* outPtr = out[oy].getData();
+        for (int ox = 0, ix = 0; ox != outWidth; ++ox) {
+            double sum = 0.0;
+            for (int iEnd = ix + binX; ix != iEnd; ++ix) {
+                sum += rowSum[ix];
+            }
+            outPtr[ox] = static_cast<OutT>(sum / norm);
+        }
+    }
+}
+
+/*
+ * Set each pixel of out to the bitwise OR of the corresponding binX*binY pixels of in
+ */
+template <typename InT, typename OutT>
+void binArrayOr(ndarray::Array<InT, 2, 1> const& in, int const binX, int const binY,
+                ndarray::Array<OutT, 2, 1> const& out) {
+    int const outWidth = out.template getSize<1>();
+    int const outHeight = out.template getSize<0>();
+    int const inWidth = outWidth * binX;
+
+    std::vector<OutT> rowOr(inWidth);
+    for (int oy = 0; oy != outHeight; ++oy) {
+        std::fill(rowOr.begin(), rowOr.end(), 0);
+        for (int iy = oy * binY, iyEnd = iy + binY; iy != iyEnd; ++iy) {
+            InT const* inPtr = in[iy].getData();
+            for (int ix = 0; ix != inWidth; ++ix) {
+                rowOr[ix] |= inPtr[ix];
+            }
+        }
+        OutT* outPtr = out[oy].getData();
+        for (int ox = 0, ix = 0; ox != outWidth; ++ox) {
+            OutT value = 0;
+            for (int iEnd = ix + binX; ix != iEnd; ++ix) {
+                value |= rowOr[ix];
+            }
+            outPtr[ox] = value;
+        }
+    }
+}
+
+/*
+ * Bin the planes of an image into an image of the binned size.  The image plane is averaged; a
+ * MaskedImage's masks are ORed and its variances are averaged and divided by the number of pixels binned.
+ */
+template <typename PixelT>
+void binPlanes(image::Image<PixelT> const& in, int const binX, int const binY, image::Image<PixelT>& out) {
+    binArraySum(in.getArray(), binX, binY, binX * binY, out.getArray());
+}
+
+template <typename PixelT>
+void binPlanes(image::MaskedImage<PixelT> const& in, int const binX, int const binY,
+               image::MaskedImage<PixelT>& out) {
+    double const nBinned = binX * binY;
+    binArraySum(in.getImage()->getArray(), binX, binY, nBinned, out.getImage()->getArray());
+    binArrayOr(in.getMask()->getArray(), binX, binY, out.getMask()->getArray());
+    binArraySum(in.getVariance()->getArray(), binX, binY, nBinned * nBinned, out.getVariance()->getArray());
+}
+
+/*
+ * Bin an array by 2, 4, ..., 2^nLevels, each level from the one before, with the intermediate levels kept
+ * in double precision.  Dividing sums of integers by powers of two is exact, so for integer inputs each
+ * level is exactly the sum that binning the input directly would give (divided by norm^level).
+ */
+template <typename InT>
+std::vector<ndarray::Array<double, 2, 1>> sumPyramid(ndarray::Array<InT, 2, 1> const& in, int const nLevels,
+                                                     double const norm) {
+    std::vector<ndarray::Array<double, 2, 1>> levels;
+    levels.reserve(nLevels);
+    int height = in.template getSize<0>() / 2;
+    int width = in.template getSize<1>() / 2;
+    levels.push_back(ndarray::allocate(height, width));
+    binArraySum(in, 2, 2, norm, levels.back());
+    for (int i = 1; i < nLevels; ++i) {
+        height /= 2;
+        width /= 2;
+        ndarray::Array<double, 2, 1> next = ndarray::allocate(height, width);
+        binArraySum(levels.back(), 2, 2, norm, next);
+        levels.push_back(next);
+    }
+    return levels;
+}
+
+template <typename OutT>
+void copyArray(ndarray::Array<double, 2, 1> const& in, ndarray::Array<OutT, 2, 1> const& out) {
+    for (int y = 0; y != in.template getSize<0>(); ++y) {
+        std::copy(in[y].begin(), in[y].end(), out[y].begin());
+    }
+}
+
+template <typename PixelT>
+std::vector<std::shared_ptr<image::Image<PixelT>>> makePyramid(image::Image<PixelT> const& in,
+                                                                int const nLevels) {
+    std::vector<std::shared_ptr<image::Image<PixelT>>> pyramid;
+    pyramid.reserve(nLevels);
+    for (auto const& level : sumPyramid(in.getArray(), nLevels, 4.0)) {
+        auto out = std::make_shared<image::Image<PixelT>>(
+                lsst::geom::Extent2I(level.template getSize<1>(), level.template getSize<0>()));
+        out->setXY0(in.getXY0());
+        copyArray(level, out->getArray());
+        pyramid.push_back(out);
+    }
+    return pyramid;
+}
+
+template <typename PixelT>
+std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> makePyramid(image::MaskedImage<PixelT> const& in,
+                                                                      int const nLevels) {
+    auto images = makePyramid(*in.getImage(), nLevels);
+    auto variances = sumPyramid(in.getVariance()->getArray(), nLevels, 16.0);
+
+    std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> pyramid;
+    pyramid.reserve(nLevels);
+    image::Mask<image::MaskPixel> const* previousMask = in.getMask().get();
+    for (int i = 0; i != nLevels; ++i) {
+        auto mask = std::make_shared<image::Mask<image::MaskPixel>>(images[i]->getDimensions());
+        binArrayOr(previousMask->getArray(), 2, 2, mask->getArray());
+        auto variance = std::make_shared<image::Image<image::VariancePixel>>(images[i]->getDimensions());
+        copyArray(variances[i], variance->getArray());
+
+        auto out = std::make_shared<image::MaskedImage<PixelT>>(images[i], mask, variance);
+        out->setXY0(in.getXY0());
+        previousMask = mask.get();
+        pyramid.push_back(out);
+    }
+    return pyramid;
+}
+}  // namespace
+
 template <typename ImageT>
 std::shared_ptr<ImageT> binImage(ImageT const& in, int const binsize, lsst::afw::math::Property const flags) {
     return binImage(in, binsize, binsize, flags);
@@ -58,31 +216,20 @@ std::shared_ptr<ImageT> binImage(ImageT const& in, int const binX, int const bin
     std::shared_ptr<ImageT> out =
             std::shared_ptr<ImageT>(new ImageT(lsst::geom::Extent2I(outWidth, outHeight)));
     out->setXY0(in.getXY0());
-    *out = typename ImageT::SinglePixel(0);
-
-    for (int oy = 0, iy = 0; oy < out->getHeight(); ++oy) {
-        for (int i = 0; i != binY; ++i, ++iy) {
-            typename ImageT::x_iterator optr = out->row_begin(oy);
-            for (typename ImageT::x_iterator iptr = in.row_begin(iy), iend = iptr + binX * outWidth;
-                 iptr < iend;) {
-                typename ImageT::SinglePixel val = *iptr;
-                ++iptr;
-                for (int j = 1; j != binX; ++j, ++iptr) {
-                    val += *iptr;
-                }
-                *optr += val;
-                ++optr;
-            }
-        }
-        for (typename ImageT::x_iterator ptr = out->row_begin(oy), end = out->row_end(oy); ptr != end;
-             ++ptr) {
-            *ptr /= binX * binY;
-        }
-    }
+    binPlanes(in, binX, binY, *out);
 
     return out;
 }
 
+template <typename ImageT>
+std::vector<std::shared_ptr<ImageT>> binImagePyramid(ImageT const& in, int const nLevels) {
+    if (nLevels <= 0) {
+        throw LSST_EXCEPT(pexExcept::DomainError,
+                          (boost::format("Number of levels must be > 0, saw %d") % nLevels).str());
+    }
+    return makePyramid(in, nLevels);
+}
+
 //
 // Explicit instantiations
 //
@@ -95,7 +242,11 @@ std::shared_ptr<ImageT> binImage(ImageT const& in, int const binX, int const bin
     template std::shared_ptr<image::MaskedImage<TYPE>> binImage(image::MaskedImage<TYPE> const&, int,      \
                                                                 lsst::afw::math::Property const);          \
     template std::shared_ptr<image::MaskedImage<TYPE>> binImage(image::MaskedImage<TYPE> const&, int, int, \
-                                                                lsst::afw::math::Property const);
+                                                                lsst::afw::math::Property const);          \
+    template std::vector<std::shared_ptr<image::Image<TYPE>>> binImagePyramid(image::Image<TYPE> const&,   \
+                                                                              int);                        \
+    template std::vector<std::shared_ptr<image::MaskedImage<TYPE>>> binImagePyramid(                       \
+            image::MaskedImage<TYPE> const&, int);
 
 INSTANTIATE(std::uint16_t)
 INSTANTIATE(int)
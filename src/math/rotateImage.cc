@@ -23,6 +23,8 @@
 /*
  * Rotate an Image (or Mask or MaskedImage) by a fixed angle or number of quarter turns
  */
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <cstdint>
 
@@ -35,54 +37,120 @@ namespace lsst {
 namespace afw {
 namespace math {
 
-template <typename ImageT>
-std::shared_ptr<ImageT> rotateImageBy90(ImageT const& inImage, int nQuarter) {
-    std::shared_ptr<ImageT> outImage;  // output image
+namespace {
+// Side of the square tiles in which quarter turns are done: a tile of both the input and the output fits
+// in the L1 cache for pixels of up to 8 bytes (2*32*32*8 bytes = 16 kB)
+int const ROTATE_TILE_SIZE = 32;
 
-    while (nQuarter < 0) {
-        nQuarter += 4;
+/*
+ * Rotate the pixels of in by nQuarter (1, 2 or 3) quarter turns into out, which has the rotated dimensions
+ *
+ * A pixel at (x, y) goes to (H - 1 - y, x), (W - 1 - x, H - 1 - y) and (y, W - 1 - x) for nQuarter = 1,
+ * 2 and 3 respectively, where the input is W x H.  Quarter turns transpose the image, so they are done a
+ * tile at a time to keep the strided reads or writes within the cache.
+ */
+template <typename PixelT>
+void rotatePlane(afwImage::ImageBase<PixelT> const& in, int const nQuarter,
+                 afwImage::ImageBase<PixelT>& out) {
+    typename afwImage::ImageBase<PixelT>::ConstArray const inArray = in.getArray();
+    typename afwImage::ImageBase<PixelT>::Array const outArray = out.getArray();
+    int const width = in.getWidth();
+    int const height = in.getHeight();
+
+    if (nQuarter == 2) {
+        for (int y = 0; y != height; ++y) {
+            std::reverse_copy(inArray[y].begin(), inArray[y].end(), outArray[height - 1 - y].begin());
+        }
+        return;
     }
 
-    switch (nQuarter % 4) {
-        case 0:
-            outImage.reset(new ImageT(inImage, true));  // a deep copy of inImage
-            break;
-        case 1:
-            outImage.reset(new ImageT(lsst::geom::Extent2I(inImage.getHeight(), inImage.getWidth())));
-
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::y_iterator optr = outImage->col_begin(inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, ++optr) {
-                    *optr = *iptr;
+    PixelT const* const inData = inArray.getData();
+    PixelT* const outData = outArray.getData();
+    auto const inStride = inArray.template getStride<0>();
+    auto const outStride = outArray.template getStride<0>();
+    for (int y0 = 0; y0 < height; y0 += ROTATE_TILE_SIZE) {
+        int const y1 = std::min(y0 + ROTATE_TILE_SIZE, height);
+        for (int x0 = 0; x0 < width; x0 += ROTATE_TILE_SIZE) {
+            int const x1 = std::min(x0 + ROTATE_TILE_SIZE, width);
+            for (int x = x0; x != x1; ++x) {
+                PixelT const* inPtr = inData + y0 * inStride + x;
+                if (nQuarter == 1) {  // output row x, columns H - 1 - y
+                    PixelT* outPtr = outData + x * outStride + (height - 1 - y0);
+                    for (int y = y0; y != y1; ++y, inPtr += inStride, --outPtr) {
+                        *outPtr = *inPtr;
+                    }
+                } else {  // output row W - 1 - x, columns y
+                    PixelT* outPtr = outData + (width - 1 - x) * outStride + y0;
+                    for (int y = y0; y != y1; ++y, inPtr += inStride, ++outPtr) {
+                        *outPtr = *inPtr;
+                    }
                 }
             }
+        }
+    }
+}
 
-            break;
-        case 2:
-            outImage.reset(new ImageT(inImage.getDimensions()));
+template <typename PixelT>
+void rotatePlane(afwImage::MaskedImage<PixelT> const& in, int const nQuarter,
+                 afwImage::MaskedImage<PixelT>& out) {
+    rotatePlane(*in.getImage(), nQuarter, *out.getImage());
+    rotatePlane(*in.getMask(), nQuarter, *out.getMask());
+    rotatePlane(*in.getVariance(), nQuarter, *out.getVariance());
+}
 
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr =
-                        outImage->x_at(inImage.getWidth() - 1, inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-            break;
-        case 3:
-            outImage.reset(new ImageT(lsst::geom::Extent2I(inImage.getHeight(), inImage.getWidth())));
-
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::y_iterator optr = outImage->y_at(y, inImage.getWidth() - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
+/*
+ * Flip the pixels of an image in place, swapping rows (or reversing them) from the top and bottom inwards
+ */
+template <typename PixelT>
+void flipPlane(afwImage::ImageBase<PixelT>& image, bool const flipLR, bool const flipTB) {
+    typename afwImage::ImageBase<PixelT>::Array const array = image.getArray();
+    int const height = image.getHeight();
+
+    if (!flipTB) {
+        if (flipLR) {
+            for (int y = 0; y != height; ++y) {
+                std::reverse(array[y].begin(), array[y].end());
             }
+        }
+        return;
+    }
+    for (int y = 0, yFlip = height - 1; y < yFlip; ++y, --yFlip) {
+        if (flipLR) {
+            std::swap_ranges(array[y].begin(), array[y].end(),
+                             std::make_reverse_iterator(array[yFlip].end()));
+        } else {
+            std::swap_ranges(array[y].begin(), array[y].end(), array[yFlip].begin());
+        }
+    }
+    if (flipLR && height % 2 == 1) {
+        std::reverse(array[height / 2].begin(), array[height / 2].end());
+    }
+}
+
+template <typename PixelT>
+void flipPlane(afwImage::MaskedImage<PixelT>& image, bool const flipLR, bool const flipTB) {
+    flipPlane(*image.getImage(), flipLR, flipTB);
+    flipPlane(*image.getMask(), flipLR, flipTB);
+    flipPlane(*image.getVariance(), flipLR, flipTB);
+}
+}  // namespace
 
-            break;
+template <typename ImageT>
+std::shared_ptr<ImageT> rotateImageBy90(ImageT const& inImage, int nQuarter) {
+    std::shared_ptr<ImageT> outImage;  // output image
+
+    while (nQuarter < 0) {
+        nQuarter += 4;
+    }
+    nQuarter %= 4;
+
+    if (nQuarter == 0) {
+        outImage.reset(new ImageT(inImage, true));  // a deep copy of inImage
+    } else {
+        lsst::geom::Extent2I const dimensions = inImage.getDimensions();
+        lsst::geom::Extent2I const rotated(dimensions.getY(), dimensions.getX());
+        outImage.reset(new ImageT(nQuarter == 2 ? dimensions : rotated));
+        rotatePlane(inImage, nQuarter, *outImage);
     }
 
     return outImage;
@@ -91,43 +159,16 @@ std::shared_ptr<ImageT> rotateImageBy90(ImageT const& inImage, int nQuarter) {
 template <typename ImageT>
 std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipTB) {
     std::shared_ptr<ImageT> outImage(new ImageT(inImage, true));  // Output image
-
-    if (flipLR) {
-        if (flipTB) {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr =
-                        outImage->x_at(inImage.getWidth() - 1, inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-        } else {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr = outImage->x_at(inImage.getWidth() - 1, y);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-        }
-    } else {
-        if (flipTB) {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr = outImage->row_begin(inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, ++optr) {
-                    *optr = *iptr;
-                }
-            }
-        } else {
-            ;  // nothing to do
-        }
-    }
+    flipImageInPlace(*outImage, flipLR, flipTB);
 
     return outImage;
 }
 
+template <typename ImageT>
+void flipImageInPlace(ImageT& image, bool flipLR, bool flipTB) {
+    flipPlane(image, flipLR, flipTB);
+}
+
 //
 // Explicit instantiations
 //
@@ -139,7 +180,9 @@ std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipT
     template std::shared_ptr<afwImage::Image<TYPE>> flipImage(afwImage::Image<TYPE> const&, bool flipLR, \
                                                               bool flipTB);                              \
     template std::shared_ptr<afwImage::MaskedImage<TYPE>> flipImage(afwImage::MaskedImage<TYPE> const&,  \
-                                                                    bool flipLR, bool flipTB);
+                                                                    bool flipLR, bool flipTB);            \
+    template void flipImageInPlace(afwImage::Image<TYPE>&, bool flipLR, bool flipTB);                     \
+    template void flipImageInPlace(afwImage::MaskedImage<TYPE>&, bool flipLR, bool flipTB);
 
 INSTANTIATE(std::uint16_t)
 INSTANTIATE(int)
@@ -149,6 +192,7 @@ template std::shared_ptr<afwImage::Mask<afwImage::MaskPixel>> rotateImageBy90(
         afwImage::Mask<afwImage::MaskPixel> const&, int);
 template std::shared_ptr<afwImage::Mask<afwImage::MaskPixel>> flipImage(
         afwImage::Mask<afwImage::MaskPixel> const&, bool flipLR, bool flipTB);
+template void flipImageInPlace(afwImage::Mask<afwImage::MaskPixel>&, bool flipLR, bool flipTB);
 /// @endcond
 }  // namespace math
 }  // namespace afw
@@ -1,6 +1,8 @@
 // -*- lsst-c++ -*-
 
+#include <cstring>
 #include <memory>
+#include <unordered_set>
 
 #include "boost/shared_ptr.hpp"  // only for ndarray
 
@@ -184,8 +186,66 @@ struct RecordDestroyer {
     char *data;
 };
 
+// A Schema Functor used to move variable-length array fields to a new location with an explicit call to
+// their move constructor, destroying the original.  All other fields are POD, and are copied in bulk.
+struct RecordMover {
+    template <typename T>
+    void operator()(SchemaItem<T> const &item) const {}
+
+    template <typename T>
+    void operator()(SchemaItem<Array<T> > const &item) const {
+        using Element = ndarray::Array<T, 1, 1>;
+        if (item.key.isVariableLength()) {
+            Element *old = reinterpret_cast<Element *>(oldData + item.key.getOffset());
+            new (newData + item.key.getOffset()) Element(std::move(*old));
+            old->~Element();
+        }
+    }
+
+    void operator()(SchemaItem<std::string> const &item) const {
+        if (item.key.isVariableLength()) {
+            using std::string;
+            string *old = reinterpret_cast<string *>(oldData + item.key.getOffset());
+            new (newData + item.key.getOffset()) string(std::move(*old));
+            old->~string();
+        }
+    }
+
+    char *oldData;
+    char *newData;
+};
+
 }  // namespace
 
+void BaseTable::_makeContiguous(std::vector<BaseRecord *> const &records) {
+    std::size_t const recordSize = _schema.getRecordSize();
+    if (records.empty() || recordSize == 0) return;
+    // Check everything before moving anything.
+    std::unordered_set<BaseRecord const *> seen;
+    std::unordered_set<BaseTable const *> checkedTables = {this};
+    for (BaseRecord const *record : records) {
+        if (!seen.insert(record).second) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "Cannot make a catalog contiguous if it contains the same record twice.");
+        }
+        if (checkedTables.insert(record->_table.get()).second && record->_table->_schema != _schema) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "Cannot make a catalog contiguous if its records have different schemas.");
+        }
+    }
+    ndarray::Manager::Ptr manager;
+    Block::preallocate(recordSize, records.size(), manager);
+    for (BaseRecord *record : records) {
+        char *oldData = reinterpret_cast<char *>(record->_data);
+        char *newData = reinterpret_cast<char *>(Block::get(recordSize, manager));
+        std::memcpy(newData, oldData, recordSize);
+        RecordMover f = {oldData, newData};
+        _schema.forEach(f);
+        record->_data = newData;
+        record->_manager = manager;
+    }
+}
+
 detail::RecordData BaseTable::_makeNewRecordData() {
     auto data = Block::get(_schema.getRecordSize(), _manager);
     return detail::RecordData{
@@ -1,11 +1,17 @@
 // -*- lsst-c++ -*-
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <typeinfo>
 #include <string>
+#include <unordered_map>
 
 #include "lsst/daf/base/PropertySet.h"
 #include "lsst/daf/base/PropertyList.h"
 #include "lsst/pex/exceptions.h"
+#include "lsst/sphgeom/UnitVector3d.h"
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/Exposure.h"
 #include "lsst/afw/table/detail/Access.h"
@@ -492,6 +498,237 @@ ExposureCatalogT<RecordT> ExposureCatalogT<RecordT>::subsetContaining(lsst::geom
     return result;
 }
 
+template <typename RecordT>
+std::vector<ExposureCatalogT<RecordT>> ExposureCatalogT<RecordT>::subsetContaining(
+        std::vector<lsst::geom::SpherePoint> const &coords, bool includeValidPolygon) const {
+    return ExposureSkyIndexT<RecordT>(*this).subsetContaining(coords, includeValidPolygon);
+}
+
+//-----------------------------------------------------------------------------------------------------------
+//----- ExposureSkyIndexT implementation --------------------------------------------------------------------
+//-----------------------------------------------------------------------------------------------------------
+
+template <typename RecordT>
+class ExposureSkyIndexT<RecordT>::Impl {
+public:
+    explicit Impl(Catalog const &catalog_) : catalog(catalog_) {
+        std::size_t const n = catalog.size();
+        _bounds.reserve(n);
+        for (auto const &record : catalog) {
+            _bounds.push_back(makeBound(record));
+        }
+        // Size cells to the typical record, so most circles land in a few of them.
+        std::vector<double> radii;
+        for (auto const &bound : _bounds) {
+            if (bound.bounded) radii.push_back(bound.radius);
+        }
+        if (!radii.empty()) {
+            std::nth_element(radii.begin(), radii.begin() + radii.size() / 2, radii.end());
+            _cellSize = std::clamp(2.0 * radii[radii.size() / 2], MIN_CELL_SIZE, M_PI);
+        }
+        _nBands = static_cast<int>(std::ceil(M_PI / _cellSize));
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!_bounds[i].bounded || !insert(i)) {
+                _unbounded.push_back(i);
+            }
+        }
+    }
+
+    // Return the (sorted) indices of the records that may contain the given point.
+    std::vector<std::size_t> getCandidates(lsst::geom::SpherePoint const &coord) const {
+        sphgeom::UnitVector3d const vector = coord.getVector();
+        std::vector<std::size_t> candidates;
+        candidates.reserve(_unbounded.size());
+        auto accept = [this, &vector](std::size_t i) {
+            Bound const &bound = _bounds[i];
+            return !bound.bounded || bound.center.dot(vector) >= bound.cosRadius;
+        };
+        auto iter = _cells.find(getCellKey(coord));
+        if (iter == _cells.end()) {
+            std::copy_if(_unbounded.begin(), _unbounded.end(), std::back_inserter(candidates), accept);
+            return candidates;
+        }
+        std::vector<std::size_t> merged;
+        merged.reserve(iter->second.size() + _unbounded.size());
+        std::merge(iter->second.begin(), iter->second.end(), _unbounded.begin(), _unbounded.end(),
+                   std::back_inserter(merged));
+        std::copy_if(merged.begin(), merged.end(), std::back_inserter(candidates), accept);
+        return candidates;
+    }
+
+    Catalog catalog;
+
+private:
+    // Smallest cell size in radians, to keep the number of declination bands bounded.
+    static constexpr double MIN_CELL_SIZE = M_PI / (1 << 20);
+    // Circles that would overlap more cells than this are tested against every point instead.
+    static constexpr std::size_t MAX_CELLS_PER_RECORD = 64;
+    // Number of points sampled along each edge of a record's bounding box.
+    static constexpr int N_EDGE_SAMPLES = 8;
+
+    struct Bound {
+        bool bounded = false;
+        lsst::geom::SpherePoint centerCoord;
+        sphgeom::UnitVector3d center;
+        double radius = 0.0;
+        double cosRadius = 0.0;
+    };
+
+    static Bound makeBound(RecordT const &record) {
+        Bound bound;
+        auto const wcs = record.getWcs();
+        lsst::geom::Box2D const box(record.getBBox());
+        if (!wcs || box.isEmpty()) {
+            return bound;
+        }
+        std::vector<lsst::geom::Point2D> points;
+        points.reserve(4 * N_EDGE_SAMPLES);
+        double const x0 = box.getMinX(), y0 = box.getMinY();
+        double const dx = box.getWidth() / N_EDGE_SAMPLES, dy = box.getHeight() / N_EDGE_SAMPLES;
+        for (int i = 0; i < N_EDGE_SAMPLES; ++i) {
+            points.emplace_back(x0 + i * dx, y0);
+            points.emplace_back(box.getMaxX(), y0 + i * dy);
+            points.emplace_back(box.getMaxX() - i * dx, box.getMaxY());
+            points.emplace_back(x0, box.getMaxY() - i * dy);
+        }
+        try {
+            lsst::geom::SpherePoint const center = wcs->pixelToSky(box.getCenter());
+            if (!center.isFinite()) {
+                return bound;
+            }
+            double radius = 0.0;
+            for (auto const &coord : wcs->pixelToSky(points)) {
+                if (!coord.isFinite()) {
+                    return bound;
+                }
+                radius = std::max(radius, center.separation(coord).asRadians());
+            }
+            // Pad for distortion between samples; caps of a hemisphere or more don't bound anything.
+            radius *= 1.01;
+            if (radius >= 0.5 * M_PI) {
+                return bound;
+            }
+            bound.bounded = true;
+            bound.centerCoord = center;
+            bound.center = center.getVector();
+            bound.radius = radius;
+            bound.cosRadius = std::cos(radius);
+        } catch (pex::exceptions::Exception &) {
+            // SkyWcs can throw for points outside the region where it is valid; test these records
+            // exactly for every point.
+        }
+        return bound;
+    }
+
+    int getBand(double dec) const {
+        int const band = static_cast<int>(std::floor((dec + 0.5 * M_PI) / _cellSize));
+        return std::clamp(band, 0, _nBands - 1);
+    }
+
+    // Number of RA cells in a band, chosen so cells are about _cellSize wide where the band is widest.
+    int getNRa(int band) const {
+        double const lower = -0.5 * M_PI + band * _cellSize;
+        double const upper = std::min(lower + _cellSize, 0.5 * M_PI);
+        double const decNearestEquator = (lower <= 0.0 && upper >= 0.0) ? 0.0 : std::min(std::abs(lower),
+                                                                                        std::abs(upper));
+        return std::max(1, static_cast<int>(2.0 * M_PI * std::cos(decNearestEquator) / _cellSize));
+    }
+
+    static std::uint64_t makeKey(int band, long raCell, int nRa) {
+        long const wrapped = ((raCell % nRa) + nRa) % nRa;
+        return (static_cast<std::uint64_t>(band) << 32) | static_cast<std::uint64_t>(wrapped);
+    }
+
+    std::uint64_t getCellKey(lsst::geom::SpherePoint const &coord) const {
+        int const band = getBand(coord.getLatitude().asRadians());
+        int const nRa = getNRa(band);
+        double const ra = coord.getLongitude().asRadians();
+        return makeKey(band, static_cast<long>(std::floor(ra * nRa / (2 * M_PI))), nRa);
+    }
+
+    // Add a record to every cell its bounding circle overlaps; return false if there are too many.
+    bool insert(std::size_t i) {
+        Bound const &bound = _bounds[i];
+        double const ra = bound.centerCoord.getLongitude().asRadians();
+        double const dec = bound.centerCoord.getLatitude().asRadians();
+        int const band0 = getBand(dec - bound.radius);
+        int const band1 = getBand(dec + bound.radius);
+        // Half-width in RA of the circle, or the full circle if it reaches a pole.
+        bool const allRa = std::abs(dec) + bound.radius >= 0.5 * M_PI;
+        double const halfWidth = allRa ? M_PI : std::asin(std::sin(bound.radius) / std::cos(dec));
+        std::vector<std::uint64_t> keys;
+        for (int band = band0; band <= band1; ++band) {
+            int const nRa = getNRa(band);
+            long raCell0 = static_cast<long>(std::floor((ra - halfWidth) * nRa / (2 * M_PI)));
+            long raCell1 = static_cast<long>(std::floor((ra + halfWidth) * nRa / (2 * M_PI)));
+            if (allRa || raCell1 - raCell0 + 1 >= nRa) {
+                raCell0 = 0;
+                raCell1 = nRa - 1;
+            }
+            if (keys.size() + (raCell1 - raCell0 + 1) > MAX_CELLS_PER_RECORD) {
+                return false;
+            }
+            for (long raCell = raCell0; raCell <= raCell1; ++raCell) {
+                keys.push_back(makeKey(band, raCell, nRa));
+            }
+        }
+        for (auto key : keys) {
+            _cells[key].push_back(i);
+        }
+        return true;
+    }
+
+    std::vector<Bound> _bounds;
+    double _cellSize = M_PI;
+    int _nBands = 1;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> _cells;
+    std::vector<std::size_t> _unbounded;
+};
+
+template <typename RecordT>
+ExposureSkyIndexT<RecordT>::ExposureSkyIndexT(Catalog const &catalog)
+        : _impl(std::make_shared<Impl>(catalog)) {}
+
+template <typename RecordT>
+ExposureSkyIndexT<RecordT>::ExposureSkyIndexT(ExposureSkyIndexT const &) = default;
+template <typename RecordT>
+ExposureSkyIndexT<RecordT>::ExposureSkyIndexT(ExposureSkyIndexT &&) = default;
+template <typename RecordT>
+ExposureSkyIndexT<RecordT> &ExposureSkyIndexT<RecordT>::operator=(ExposureSkyIndexT const &) = default;
+template <typename RecordT>
+ExposureSkyIndexT<RecordT> &ExposureSkyIndexT<RecordT>::operator=(ExposureSkyIndexT &&) = default;
+template <typename RecordT>
+ExposureSkyIndexT<RecordT>::~ExposureSkyIndexT() = default;
+
+template <typename RecordT>
+typename ExposureSkyIndexT<RecordT>::Catalog const &ExposureSkyIndexT<RecordT>::getCatalog() const {
+    return _impl->catalog;
+}
+
+template <typename RecordT>
+typename ExposureSkyIndexT<RecordT>::Catalog ExposureSkyIndexT<RecordT>::subsetContaining(
+        lsst::geom::SpherePoint const &coord, bool includeValidPolygon) const {
+    Catalog const &catalog = _impl->catalog;
+    Catalog result(catalog.getTable());
+    for (std::size_t i : _impl->getCandidates(coord)) {
+        if (catalog[i].contains(coord, includeValidPolygon)) {
+            result.push_back(catalog.get(i));
+        }
+    }
+    return result;
+}
+
+template <typename RecordT>
+std::vector<typename ExposureSkyIndexT<RecordT>::Catalog> ExposureSkyIndexT<RecordT>::subsetContaining(
+        std::vector<lsst::geom::SpherePoint> const &coords, bool includeValidPolygon) const {
+    std::vector<Catalog> result;
+    result.reserve(coords.size());
+    for (auto const &coord : coords) {
+        result.push_back(subsetContaining(coord, includeValidPolygon));
+    }
+    return result;
+}
+
 //-----------------------------------------------------------------------------------------------------------
 //----- Explicit instantiation ------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------------------
@@ -504,6 +741,9 @@ template class SortedCatalogT<ExposureRecord const>;
 
 template class ExposureCatalogT<ExposureRecord>;
 template class ExposureCatalogT<ExposureRecord const>;
+
+template class ExposureSkyIndexT<ExposureRecord>;
+template class ExposureSkyIndexT<ExposureRecord const>;
 }  // namespace table
 }  // namespace afw
 }  // namespace lsst
@@ -90,8 +90,8 @@ namespace detail {
 
 template <typename T>
 SchemaItem<T> SchemaImpl::find(std::string const &name) const {
-    NameMap::const_iterator i = _names.lower_bound(name);
-    if (i != _names.end() && i->first == name) {
+    NameIndex::const_iterator i = _nameIndex.find(name);
+    if (i != _nameIndex.end()) {
         // got an exact match; we're done if it has the right type, and dead if it doesn't.
         try {
             return std::get<SchemaItem<T>>(_items[i->second]);
@@ -214,6 +214,8 @@ void SchemaImpl::replaceField(Key<T> const &key, Field<T> const &field) {
         }
         j = _names.find(item->field.getName());
         _names.insert(j, std::pair<std::string, std::size_t>(field.getName(), j->second));
+        _nameIndex.erase(j->first);
+        _nameIndex.emplace(field.getName(), j->second);
         _names.erase(j);
     }
     item->field = field;
@@ -359,6 +361,7 @@ Key<Flag> SchemaImpl::addField(Field<Flag> const &field, bool doReplace) {
         ++_lastFlagBit;
         _flags.insert(std::pair<std::pair<size_t, size_t>, size_t>(
                 std::make_pair(item.key.getOffset(), item.key.getBit()), _items.size()));
+        _nameIndex.emplace(field.getName(), _items.size());
         _items.push_back(item);
         return item.key;
     }
@@ -404,6 +407,7 @@ Key<T> SchemaImpl::addFieldImpl(std::size_t elementSize, std::size_t elementCoun
         SchemaItem<T> item(detail::Access::makeKey(field, _recordSize), field);
         _recordSize += elementCount * elementSize;
         _offsets.insert(std::pair<std::size_t, std::size_t>(item.key.getOffset(), _items.size()));
+        _nameIndex.emplace(field.getName(), _items.size());
         _items.push_back(item);
         return item.key;
     }
@@ -470,6 +474,19 @@ SchemaItem<T> Schema::find(std::string const &name) const {
     return _impl->find<T>(tmp);
 }
 
+template <typename T>
+std::vector<Key<T>> Schema::findKeys(std::vector<std::string> const &names) const {
+    std::vector<Key<T>> result;
+    result.reserve(names.size());
+    std::string tmp;
+    for (auto const &name : names) {
+        tmp = name;
+        _aliases->_apply(tmp);
+        result.push_back(_impl->find<T>(tmp).key);
+    }
+    return result;
+}
+
 template <typename T>
 SchemaItem<T> Schema::find(Key<T> const &key) const {
     return _impl->find(key);
@@ -599,13 +616,14 @@ std::set<std::string> SubSchema::getNames(bool topOnly) const { return _impl->ge
 // implementation functions.  If you move some of those to a different source file, you'll need
 // more explicit instantiation.
 
-#define INSTANTIATE_LAYOUT(r, data, elem)                                              \
-    template Key<elem> Schema::addField(Field<elem> const &, bool);                    \
-    template SchemaItem<elem> Schema::find(std::string const &) const;                 \
-    template SchemaItem<elem> Schema::find(Key<elem> const &) const;                   \
-    template SchemaItem<elem> detail::SchemaImpl::find(std::string const &name) const; \
-    template int Schema::contains(SchemaItem<elem> const &, int) const;                \
-    template void Schema::replaceField(Key<elem> const &, Field<elem> const &);        \
+#define INSTANTIATE_LAYOUT(r, data, elem)                                                     \
+    template Key<elem> Schema::addField(Field<elem> const &, bool);                           \
+    template SchemaItem<elem> Schema::find(std::string const &) const;                        \
+    template SchemaItem<elem> Schema::find(Key<elem> const &) const;                          \
+    template std::vector<Key<elem>> Schema::findKeys(std::vector<std::string> const &) const; \
+    template SchemaItem<elem> detail::SchemaImpl::find(std::string const &name) const;        \
+    template int Schema::contains(SchemaItem<elem> const &, int) const;                       \
+    template void Schema::replaceField(Key<elem> const &, Field<elem> const &);               \
     template SchemaItem<elem> SubSchema::find(std::string const &) const;
 
 BOOST_PP_SEQ_FOR_EACH(INSTANTIATE_LAYOUT, _,
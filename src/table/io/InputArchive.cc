@@ -1,5 +1,8 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <optional>
+
 #include "boost/format.hpp"
 
 #include "lsst/pex/exceptions.h"
@@ -31,6 +34,38 @@ struct IndexSortCompare {
     }
 };
 
+// Read the index catalog at the current HDU, returning the total number of catalogs in the archive.
+BaseCatalog readIndexCatalog(fits::Fits& fitsfile, int& nCatalogs) {
+    BaseCatalog index = BaseCatalog::readFits(fitsfile);
+    std::shared_ptr<daf::base::PropertyList> metadata = index.getTable()->popMetadata();
+    assert(metadata);  // BaseCatalog::readFits should always read metadata, even if there's nothing there
+    if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_INDEX") {
+        throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
+                               boost::format("Wrong value for archive index EXTTYPE: '%s'") %
+                                       metadata->get<std::string>("EXTTYPE"));
+    }
+    nCatalogs = metadata->get<int>("AR_NCAT");
+    return index;
+}
+
+// Read the data catalog at the current HDU, checking that it is the nth catalog of an archive.
+BaseCatalog readDataCatalog(fits::Fits& fitsfile, int n) {
+    BaseCatalog catalog = BaseCatalog::readFits(fitsfile);
+    std::shared_ptr<daf::base::PropertyList> metadata = catalog.getTable()->popMetadata();
+    if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_DATA") {
+        throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
+                               boost::format("Wrong value for archive data EXTTYPE: '%s'") %
+                                       metadata->get<std::string>("EXTTYPE"));
+    }
+    if (metadata->get<int>("AR_CATN") != n) {
+        throw LSST_FITS_EXCEPT(
+                fits::FitsError, fitsfile,
+                boost::format("Incorrect order for archive catalogs: AR_CATN=%d found at position %d") %
+                        metadata->get<int>("AR_CATN") % n);
+    }
+    return catalog;
+}
+
 }  // namespace
 
 // ----- InputArchive::Impl ---------------------------------------------------------------------------------
@@ -82,7 +117,7 @@ public:
                              indexIter->get(indexKeys.id) % catN % _catalogs.size())
                                     .str());
                 }
-                BaseCatalog& fullCatalog = _catalogs[catN];
+                BaseCatalog& fullCatalog = getCatalog(catN);
                 std::size_t i1 = indexIter->get(indexKeys.row0);
                 std::size_t i2 = i1 + indexIter->get(indexKeys.nRows);
                 if (i2 > fullCatalog.size()) {
@@ -134,14 +169,28 @@ public:
         return _map;
     }
 
+    // Return a data catalog, reading it from the FITS file first if it has not been loaded yet.
+    BaseCatalog& getCatalog(std::size_t catN) {
+        std::optional<BaseCatalog>& catalog = _catalogs[catN];
+        if (!catalog) {
+            assert(_fitsFile);  // only lazy archives have catalogs that have not been loaded
+            int const n = catN + 1;
+            fits::HduMoveGuard guard(*_fitsFile, _indexHdu + n);
+            catalog = readDataCatalog(*_fitsFile, n);
+        }
+        return *catalog;
+    }
+
     Impl() : _index(ArchiveIndexSchema::get().schema) {}
 
-    Impl(BaseCatalog const& index, CatalogVector const& catalogs) : _index(index), _catalogs(catalogs) {
-        if (index.getSchema() != indexKeys.schema) {
-            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Incorrect schema for index catalog");
-        }
-        _map.insert(std::make_pair(0, std::shared_ptr<Persistable>()));
-        _index.sort(IndexSortCompare());
+    Impl(BaseCatalog const& index, CatalogVector const& catalogs) : _index(index) {
+        _catalogs.assign(catalogs.begin(), catalogs.end());
+        _init();
+    }
+
+    Impl(BaseCatalog const& index, std::size_t nCatalogs, fits::Fits& fitsfile, int indexHdu)
+            : _index(index), _catalogs(nCatalogs), _fitsFile(&fitsfile), _indexHdu(indexHdu) {
+        _init();
     }
 
     // No copying
@@ -154,7 +203,18 @@ public:
 
     Map _map;
     BaseCatalog _index;
-    CatalogVector _catalogs;
+    std::vector<std::optional<BaseCatalog>> _catalogs;
+    fits::Fits* _fitsFile = nullptr;  // file to read unloaded catalogs from; null unless lazy
+    int _indexHdu = 0;
+
+private:
+    void _init() {
+        if (_index.getSchema() != indexKeys.schema) {
+            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Incorrect schema for index catalog");
+        }
+        _map.insert(std::make_pair(0, std::shared_ptr<Persistable>()));
+        _index.sort(IndexSortCompare());
+    }
 };
 
 // ----- InputArchive ---------------------------------------------------------------------------------------
@@ -181,36 +241,26 @@ std::shared_ptr<Persistable> InputArchive::get(int id) const { return _impl->get
 InputArchive::Map const& InputArchive::getAll() const { return _impl->getAll(*this); }
 
 InputArchive InputArchive::readFits(fits::Fits& fitsfile) {
-    BaseCatalog index = BaseCatalog::readFits(fitsfile);
-    std::shared_ptr<daf::base::PropertyList> metadata = index.getTable()->popMetadata();
-    assert(metadata);  // BaseCatalog::readFits should always read metadata, even if there's nothing there
-    if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_INDEX") {
-        throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
-                               boost::format("Wrong value for archive index EXTTYPE: '%s'") %
-                                       metadata->get<std::string>("EXTTYPE"));
-    }
-    int nCatalogs = metadata->get<int>("AR_NCAT");
+    int nCatalogs = 0;
+    BaseCatalog index = readIndexCatalog(fitsfile, nCatalogs);
     CatalogVector catalogs;
     catalogs.reserve(nCatalogs);
     for (int n = 1; n < nCatalogs; ++n) {
         fitsfile.setHdu(1, true);  // increment HDU by one
-        catalogs.push_back(BaseCatalog::readFits(fitsfile));
-        metadata = catalogs.back().getTable()->popMetadata();
-        if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_DATA") {
-            throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
-                                   boost::format("Wrong value for archive data EXTTYPE: '%s'") %
-                                           metadata->get<std::string>("EXTTYPE"));
-        }
-        if (metadata->get<int>("AR_CATN") != n) {
-            throw LSST_FITS_EXCEPT(
-                    fits::FitsError, fitsfile,
-                    boost::format("Incorrect order for archive catalogs: AR_CATN=%d found at position %d") %
-                            metadata->get<int>("AR_CATN") % n);
-        }
+        catalogs.push_back(readDataCatalog(fitsfile, n));
     }
     std::shared_ptr<Impl> impl(new Impl(index, catalogs));
     return InputArchive(impl);
 }
+
+InputArchive InputArchive::readFitsLazy(fits::Fits& fitsfile) {
+    int const indexHdu = fitsfile.getHdu();
+    int nCatalogs = 0;
+    BaseCatalog index = readIndexCatalog(fitsfile, nCatalogs);
+    std::shared_ptr<Impl> impl(new Impl(index, std::max(nCatalogs - 1, 0), fitsfile, indexHdu));
+    return InputArchive(impl);
+}
+
 }  // namespace io
 }  // namespace table
 }  // namespace afw
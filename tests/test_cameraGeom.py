@@ -33,6 +33,7 @@ from lsst.afw.cameraGeom import (
     AmplifierIsolator,
     assembleAmplifierImage,
     assembleAmplifierRawImage,
+    assembleDetector,
     Camera,
     CameraSys,
     CameraSysPrefix,
@@ -236,6 +237,35 @@ class CameraGeomTestCase(lsst.utils.tests.TestCase):
             for dets in detList:
                 self.assertEqual(len(dets), 1)
 
+    def testFindDetectorsIndexed(self):
+        """Check that the focal-plane index gives the same results as testing
+        every detector.
+        """
+        rng = np.random.RandomState(3)
+        for cw in self.cameraList:
+            camera = cw.camera
+            fpBBox = camera.getFpBBox()
+            fpBBox.grow(0.1*fpBBox.getWidth())
+            points = [lsst.geom.Point2D(x, y) for x, y in
+                      zip(rng.uniform(fpBBox.getMinX(), fpBBox.getMaxX(), 500),
+                          rng.uniform(fpBBox.getMinY(), fpBBox.getMaxY(), 500))]
+            # Include points exactly on detector corners.
+            for det in camera:
+                points.extend(det.getCorners(FOCAL_PLANE))
+            expected = []
+            for point in points:
+                expected.append([det.getName() for det in camera
+                                 if lsst.geom.Box2D(det.getBBox()).contains(
+                                     det.transform(point, FOCAL_PLANE, PIXELS))])
+            for point, names in zip(points, expected):
+                self.assertEqual([det.getName() for det in camera.findDetectors(point, FOCAL_PLANE)],
+                                 names)
+            for nThreads in (1, 3):
+                detLists = camera.findDetectorsList(points, FOCAL_PLANE, nThreads=nThreads)
+                self.assertEqual([[det.getName() for det in dets] for dets in detLists], expected)
+            with self.assertRaises(pexExcept.InvalidParameterError):
+                camera.findDetectorsList(points, FOCAL_PLANE, nThreads=0)
+
     def testFpBbox(self):
         for cw in self.cameraList:
             camera = cw.camera
@@ -309,6 +339,75 @@ class CameraGeomTestCase(lsst.utils.tests.TestCase):
                                              amp_exposure.getBBox())
                             self.assertImagesEqual(im[amp.getRawDataBBox()], amp_exposure.image)
 
+    @staticmethod
+    def _assembleArray(rawArray, rawXY0, det, outBBox, trim):
+        """Assemble the amplifiers of a detector from a raw pixel array with
+        numpy slicing, independently of the C++ assembly code.
+        """
+        def slices(bbox, xy0):
+            return (slice(bbox.getBeginY() - xy0.getY(), bbox.getEndY() - xy0.getY()),
+                    slice(bbox.getBeginX() - xy0.getX(), bbox.getEndX() - xy0.getX()))
+
+        result = np.zeros((outBBox.getHeight(), outBBox.getWidth()), dtype=rawArray.dtype)
+        for amp in det:
+            if trim:
+                inBBox = amp.getRawDataBBox()
+                ampBBox = amp.getBBox()
+            else:
+                inBBox = amp.getRawBBox()
+                ampBBox = lsst.geom.Box2I(amp.getRawBBox())
+                ampBBox.shift(amp.getRawXYOffset())
+            data = rawArray[slices(inBBox, rawXY0)]
+            if amp.getRawFlipX():
+                data = data[:, ::-1]
+            if amp.getRawFlipY():
+                data = data[::-1, :]
+            result[slices(ampBBox, outBBox.getMin())] = data
+        return result
+
+    def testAssembleDetector(self):
+        """Test assembling all amplifiers of a detector from a single raw
+        image at once.
+        """
+        camera = self.scCamWrapper.camera
+        rawImage = self.assemblyList[camera.getName()][0]
+        rawImage.array[:, :] = np.arange(rawImage.array.size).reshape(rawImage.array.shape) % 65521
+        # 64-bit images, with values that don't fit in 32 bits.
+        rawImageL = afwImage.ImageL(rawImage.getBBox())
+        rawImageL.array[:, :] = rawImage.array + 2**40
+        for det in camera:
+            for trim in (True, False):
+                outBBox = det.getBBox() if trim else cameraGeomUtils.calcRawCcdBBox(det)
+                expected = self._assembleArray(rawImage.array, rawImage.getXY0(), det, outBBox, trim)
+                for nThreads in (1, 3):
+                    with self.subTest(det=det.getName(), trim=trim, nThreads=nThreads):
+                        outImage = afwImage.ImageU(outBBox)
+                        assembleDetector(outImage, rawImage, det, trim=trim, nThreads=nThreads)
+                        self.assertEqual(outImage.getBBox(), outBBox)
+                        np.testing.assert_array_equal(outImage.array, expected)
+                        # Assemble straight into an Exposure.
+                        rawExposure = afwImage.ExposureU(afwImage.MaskedImageU(rawImage))
+                        rawExposure.mask.array[:, :] = rawImage.array % 7
+                        outExposure = afwImage.ExposureU(outBBox)
+                        assembleDetector(outExposure, rawExposure, det, trim=trim, nThreads=nThreads)
+                        np.testing.assert_array_equal(outExposure.image.array, expected)
+                        expectedMask = self._assembleArray(rawExposure.mask.array, rawImage.getXY0(),
+                                                           det, outBBox, trim)
+                        np.testing.assert_array_equal(outExposure.mask.array, expectedMask)
+                expectedL = self._assembleArray(rawImageL.array, rawImageL.getXY0(), det, outBBox, trim)
+                with self.subTest(det=det.getName(), trim=trim, pixel="L"):
+                    outImageL = afwImage.ImageL(outBBox)
+                    assembleDetector(outImageL, rawImageL, det, trim=trim, nThreads=3)
+                    np.testing.assert_array_equal(outImageL.array, expectedL)
+                    # The Python single-amplifier functions support all pixel types, too.
+                    assemble = assembleAmplifierImage if trim else assembleAmplifierRawImage
+                    outImageL = afwImage.ImageL(outBBox)
+                    for amp in det:
+                        assemble(outImageL, rawImageL, amp)
+                    np.testing.assert_array_equal(outImageL.array, expectedL)
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            assembleDetector(afwImage.ImageU(det.getBBox()), rawImage, det, nThreads=0)
+
     @unittest.skipIf(not display, "display variable not set; skipping cameraGeomUtils test")
     def testCameraGeomUtils(self):
         for cw in self.cameraList:
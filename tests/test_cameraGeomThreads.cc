@@ -0,0 +1,76 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CameraGeomThreadsCpp
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/cameraGeom/detail/threads.h"
+
+namespace lsst {
+namespace afw {
+namespace cameraGeom {
+
+BOOST_AUTO_TEST_CASE(ParallelForRangesCoversRange) {
+    for (int nThreads : {1, 2, 3, 16}) {
+        for (std::size_t size : {0, 1, 5, 17}) {
+            std::vector<std::atomic<int>> counts(size);
+            detail::parallelForRanges(size, nThreads, [&counts](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    ++counts[i];
+                }
+            });
+            for (auto const &count : counts) {
+                BOOST_CHECK_EQUAL(count.load(), 1);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelForRangesRethrows) {
+    // Only some of the workers throw; the rest must still be joined.
+    auto throwInSecondHalf = [](std::size_t, std::size_t end) {
+        if (end > 5) {
+            throw std::out_of_range("worker failed");
+        }
+    };
+    BOOST_CHECK_THROW(detail::parallelForRanges(10, 4, throwInSecondHalf), std::out_of_range);
+    BOOST_CHECK_THROW(detail::parallelForRanges(10, 1, throwInSecondHalf), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelForRangesChecksThreads) {
+    auto noop = [](std::size_t, std::size_t) {};
+    BOOST_CHECK_THROW(detail::parallelForRanges(10, 0, noop), pex::exceptions::InvalidParameterError);
+    BOOST_CHECK_THROW(detail::checkNumThreads(-1), pex::exceptions::InvalidParameterError);
+    BOOST_CHECK_NO_THROW(detail::checkNumThreads(1));
+}
+
+}  // namespace cameraGeom
+}  // namespace afw
+}  // namespace lsst
@@ -0,0 +1,65 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE table - catalog
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include <limits>
+#include <vector>
+
+#include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/Schema.h"
+
+BOOST_AUTO_TEST_CASE(sortByKey) {
+    using namespace lsst::afw::table;
+
+    Schema schema;
+    Key<double> valueKey = schema.addField<double>("value", "sort key");
+    Key<int> orderKey = schema.addField<int>("order", "original position");
+    BaseCatalog catalog(schema);
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> const values = {3.0, nan, 1.0, 3.0, 2.0, nan, 1.0};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        auto record = catalog.addNew();
+        record->set(valueKey, values[i]);
+        record->set(orderKey, static_cast<int>(i));
+    }
+
+    catalog.sort(valueKey);
+    BOOST_CHECK(catalog.isSorted(valueKey));
+    // Equal values keep their original order, and NaNs go last.
+    std::vector<int> const expected = {2, 6, 4, 0, 3, 1, 5};
+    BOOST_REQUIRE_EQUAL(catalog.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        BOOST_CHECK_EQUAL(catalog[i].get(orderKey), expected[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(indexById) {
+    using namespace lsst::afw::table;
+
+    Schema schema;
+    Key<RecordId> idKey = schema.addField<RecordId>("id", "unique ID");
+    BaseCatalog catalog(schema);
+    std::vector<RecordId> const ids = {17, 3, 42, 8, 3};
+    for (auto id : ids) {
+        catalog.addNew()->set(idKey, id);
+    }
+    BOOST_CHECK(!catalog.isSorted(idKey));
+
+    auto index = catalog.makeIndex(idKey);
+    BOOST_CHECK_EQUAL(index.size(), 4u);
+    BOOST_CHECK(index.getKey() == idKey);
+    BOOST_CHECK_EQUAL(index.find(42), catalog.get(2));
+    BOOST_CHECK_EQUAL(index.find(8), catalog.get(3));
+    // Duplicate values resolve to the first record.
+    BOOST_CHECK_EQUAL(index.find(3), catalog.get(1));
+    BOOST_CHECK(!index.find(5));
+
+    // The index is a snapshot: sorting the catalog does not invalidate it.
+    catalog.sort(idKey);
+    BOOST_CHECK_EQUAL(index.find(42)->get(idKey), 42u);
+}
@@ -148,6 +148,27 @@ class ChebyshevBoundedFieldTestCase(lsst.utils.tests.TestCase):
             self.assertFloatsEqual(
                 scaled.getCoefficients(), factor*field.getCoefficients())
 
+    def testEvaluateGrid(self):
+        """Test that evaluateGrid matches evaluate on the same points, and
+        that the image methods that use it match pixel-by-pixel evaluation.
+        """
+        for ctrl, coefficients in self.cases:
+            field = lsst.afw.math.ChebyshevBoundedField(self.bbox, coefficients)
+            grid = field.evaluateGrid(self.x1d, self.y1d)
+            self.assertEqual(grid.shape, (self.y1d.size, self.x1d.size))
+            self.assertFloatsAlmostEqual(grid, field.evaluate(self.xFlat, self.yFlat).reshape(grid.shape),
+                                         rtol=1E-12, atol=1E-12)
+            image = lsst.afw.image.ImageD(self.bbox)
+            field.fillImage(image)
+            expect = lsst.afw.image.ImageD(self.bbox)
+            for x in range(self.bbox.getMinX(), self.bbox.getMaxX() + 1):
+                for y in range(self.bbox.getMinY(), self.bbox.getMaxY() + 1):
+                    expect[x, y] = field.evaluate(x, y)
+            self.assertImagesAlmostEqual(image, expect, rtol=1E-12, atol=1E-12)
+        grid = self.product.evaluateGrid(self.x1d, self.y1d)
+        self.assertFloatsAlmostEqual(grid, self.product.evaluate(self.xFlat, self.yFlat).reshape(grid.shape),
+                                     rtol=1E-12, atol=1E-12)
+
     def testProductEvaluate(self):
         """Test that ProductBoundedField.evaluate is equivalent to multiplying
         its nested BoundedFields.
@@ -370,6 +391,40 @@ class ChebyshevBoundedFieldTestCase(lsst.utils.tests.TestCase):
                 self.assertFloatsAlmostEqual(
                     outField2.getCoefficients(), coefficients, rtol=1E-7, atol=1E-7)
 
+    def testNoisyFit(self):
+        """Test that fits to more points than are accumulated at once match a
+        direct least-squares solution.
+        """
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(-20, 10), lsst.geom.Extent2I(60, 45))
+        boxD = lsst.geom.Box2D(bbox)
+        ctrl = lsst.afw.math.ChebyshevBoundedFieldControl()
+        ctrl.orderX = 3
+        ctrl.orderY = 2
+        ctrl.triangular = False
+        rng = np.random.RandomState(3)
+        image = lsst.afw.image.ImageD(bbox)
+        image.array[:, :] = rng.randn(*image.array.shape)
+        y, x = np.indices(image.array.shape, dtype=float)
+        x = x.ravel() + bbox.getMinX()
+        y = y.ravel() + bbox.getMinY()
+        w = rng.uniform(0.5, 2.0, x.size)
+        z = image.array.ravel()
+        sx = 2.0*(x - boxD.getCenterX())/boxD.getWidth()
+        sy = 2.0*(y - boxD.getCenterY())/boxD.getHeight()
+        design = np.polynomial.chebyshev.chebvander2d(sx, sy, [ctrl.orderX, ctrl.orderY])
+
+        def solve(design, data):
+            solution = np.linalg.lstsq(design, data, rcond=None)[0]
+            return solution.reshape(ctrl.orderX + 1, ctrl.orderY + 1).transpose()
+
+        field = lsst.afw.math.ChebyshevBoundedField.fit(image, ctrl)
+        self.assertFloatsAlmostEqual(field.getCoefficients(), solve(design, z), rtol=1E-10, atol=1E-12)
+        field = lsst.afw.math.ChebyshevBoundedField.fit(bbox, x, y, z, ctrl)
+        self.assertFloatsAlmostEqual(field.getCoefficients(), solve(design, z), rtol=1E-10, atol=1E-12)
+        field = lsst.afw.math.ChebyshevBoundedField.fit(bbox, x, y, z, w, ctrl)
+        self.assertFloatsAlmostEqual(field.getCoefficients(), solve(design*w[:, np.newaxis], z*w),
+                                     rtol=1E-10, atol=1E-12)
+
     def testApproximate(self):
         """Test the approximate instantiation with the example of
         fitting a PixelAreaBoundedField to reasonable precision.
@@ -30,6 +30,7 @@ import lsst.utils.tests
 import lsst.pex.exceptions
 import lsst.geom
 import lsst.afw.geom
+import lsst.afw.image
 import lsst.afw.cameraGeom as cameraGeom
 from lsst.afw.cameraGeom.testUtils import DetectorWrapper
 
@@ -226,6 +227,69 @@ class DetectorTestCase(lsst.utils.tests.TestCase):
             self.assertNotEqual(amp.getRawXYOffset(), namp.getRawXYOffset())
             self.assertEqual(namp.getRawXYOffset()[0], i)
 
+    def testSubtractCrosstalk(self):
+        """Test subtractCrosstalk against a direct NumPy implementation.
+        """
+        ReadoutCorner = cameraGeom.ReadoutCorner
+        corners = [ReadoutCorner.LL, ReadoutCorner.LR, ReadoutCorner.UR, ReadoutCorner.UL]
+        extent = lsst.geom.Extent2I(7, 5)
+        bboxes = [lsst.geom.Box2I(lsst.geom.Point2I(i*extent.getX(), 0), extent) for i in range(4)]
+
+        def layoutAmps(dw):
+            for i, amp in enumerate(dw.ampList):
+                amp.setBBox(bboxes[i])
+                amp.setReadoutCorner(corners[i])
+                amp.setRawBBox(bboxes[i])
+                amp.setRawDataBBox(bboxes[i])
+                amp.setRawFlipX(i == 1)
+
+        rng = np.random.RandomState(2)
+        crosstalk = rng.uniform(-1E-3, 1E-3, size=(4, 4)).astype(np.float32)
+        dw = DetectorWrapper(numAmps=4, ampExtent=extent, crosstalk=crosstalk, modFunc=layoutAmps,
+                             bbox=lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(28, 5)))
+        original = lsst.afw.image.MaskedImageF(dw.detector.getBBox())
+        original.image.array[:, :] = rng.uniform(0.0, 1000.0, size=original.image.array.shape)
+        detected = original.mask.getPlaneBitMask("DETECTED")
+        original.mask.array[:, :] = np.where(rng.uniform(size=original.mask.array.shape) > 0.5, detected, 0)
+
+        def toReadoutOrder(array, corner, flipX):
+            if (corner in (ReadoutCorner.LR, ReadoutCorner.UR)) != flipX:
+                array = array[:, ::-1]
+            if corner in (ReadoutCorner.UL, ReadoutCorner.UR):
+                array = array[::-1, :]
+            return array
+
+        def computeExpected(trim, threshold, useMask):
+            values = original.image.array.astype(np.float64)
+            sources = np.where(values > threshold, values, 0.0)
+            if useMask:
+                sources = np.where(original.mask.array & detected, sources, 0.0)
+            result = values.copy()
+            for v, victim in enumerate(dw.detector):
+                flipV = victim.getRawFlipX() and not trim
+                out = toReadoutOrder(result[:, v*7:(v + 1)*7], victim.getReadoutCorner(), flipV)
+                for s, source in enumerate(dw.detector):
+                    if s != v:
+                        flipS = source.getRawFlipX() and not trim
+                        out -= crosstalk[v, s]*toReadoutOrder(sources[:, s*7:(s + 1)*7],
+                                                              source.getReadoutCorner(), flipS)
+            return result
+
+        for trim in (True, False):
+            for threshold, sourceMask in ((-np.inf, 0), (400.0, 0), (400.0, detected)):
+                expected = computeExpected(trim, threshold, sourceMask != 0)
+                for nThreads in (1, 3):
+                    with self.subTest(trim=trim, threshold=threshold, sourceMask=sourceMask,
+                                      nThreads=nThreads):
+                        image = original.clone()
+                        cameraGeom.subtractCrosstalk(image, dw.detector, trim=trim, threshold=threshold,
+                                                     sourceMask=sourceMask, nThreads=nThreads)
+                        self.assertFloatsAlmostEqual(image.image.array, expected, rtol=1E-6)
+                        self.assertMasksEqual(image.mask, original.mask)
+                        self.assertImagesEqual(image.variance, original.variance)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            cameraGeom.subtractCrosstalk(original, dw.detector, nThreads=0)
+
     def testPersistence(self):
         """Test round-tripping a Detector through FITS I/O.
         """
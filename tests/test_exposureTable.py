@@ -40,7 +40,7 @@ import lsst.geom
 import lsst.afw.table
 from lsst.afw.coord import Observatory, Weather
 from lsst.geom import arcseconds, degrees, radians, Point2D, Extent2D, Box2D, SpherePoint
-from lsst.afw.geom import Polygon, makeSkyWcs
+from lsst.afw.geom import Polygon, makeCdMatrix, makeSkyWcs
 import lsst.afw.image
 import lsst.afw.detection
 from lsst.afw.cameraGeom.testUtils import DetectorWrapper
@@ -234,6 +234,69 @@ class ExposureTableTestCase(lsst.utils.tests.TestCase):
         subset3 = self.cat.subsetContaining(crazyPoint)
         self.assertEqual(len(subset3), 0)
 
+    def testSkyIndex(self):
+        # Tile a region with many small records, and add tiles with their own
+        # WCSs that straddle RA=0, cover a pole, and (near the other pole)
+        # are too large to index, and check that indexed queries give the
+        # same results as linear ones.
+        catalog = lsst.afw.table.ExposureCatalog(self.cat.getSchema())
+        origin = self.wcs.getPixelOrigin()
+        for i in range(10):
+            for j in range(10):
+                record = catalog.addNew()
+                record.setId(10*i + j + 1)
+                record.setBBox(lsst.geom.Box2I(lsst.geom.Point2I(int(origin.getX()) + 40*i - 200,
+                                                                 int(origin.getY()) + 40*j - 200),
+                                               lsst.geom.Extent2I(50, 50)))
+                record.setWcs(self.wcs)
+        catalog.append(self.cat[1])
+        tileWcsList = [
+            # Small rotated tiles on both sides of RA=0.
+            makeSkyWcs(crpix=Point2D(0.0, 0.0), crval=SpherePoint(0.0*degrees, 10.0*degrees),
+                       cdMatrix=makeCdMatrix(scale=0.2*arcseconds, orientation=30.0*degrees)),
+            # Small tiles, some of which contain the north pole.
+            makeSkyWcs(crpix=Point2D(0.0, 0.0), crval=SpherePoint(120.0*degrees, 89.999*degrees),
+                       cdMatrix=makeCdMatrix(scale=0.2*arcseconds, orientation=-45.0*degrees)),
+            # Tiles a few degrees across near the south pole, which overlap
+            # too many cells to be indexed.
+            makeSkyWcs(crpix=Point2D(0.0, 0.0), crval=SpherePoint(350.0*degrees, -89.0*degrees),
+                       cdMatrix=makeCdMatrix(scale=150.0*arcseconds, orientation=10.0*degrees)),
+        ]
+        for n, tileWcs in enumerate(tileWcsList):
+            for i in range(4):
+                for j in range(4):
+                    record = catalog.addNew()
+                    record.setId(1000*(n + 1) + 4*i + j)
+                    record.setBBox(lsst.geom.Box2I(lsst.geom.Point2I(40*i - 80, 40*j - 80),
+                                                   lsst.geom.Extent2I(50, 50)))
+                    record.setWcs(tileWcs)
+        index = lsst.afw.table.ExposureSkyIndex(catalog)
+        self.assertEqual(len(index.getCatalog()), len(catalog))
+        rng = np.random.RandomState(45)
+        coords = [self.wcs.pixelToSky(origin + lsst.geom.Extent2D(x, y))
+                  for x, y in rng.uniform(-250.0, 250.0, size=(200, 2))]
+        for tileWcs in tileWcsList:
+            coords.extend(tileWcs.pixelToSky(x, y) for x, y in rng.uniform(-100.0, 100.0, size=(200, 2)))
+        coords.append(SpherePoint(self.wcs.getSkyOrigin().getLongitude() + np.pi*radians,
+                                  self.wcs.getSkyOrigin().getLatitude()))
+        coords.append(SpherePoint(0.0*degrees, 90.0*degrees))
+        coords.append(SpherePoint(0.0*degrees, -90.0*degrees))
+        batched = catalog.subsetContaining(coords, includeValidPolygon=True)
+        self.assertEqual(len(batched), len(coords))
+        found = set()
+        for coord, subset in zip(coords, batched):
+            for includeValidPolygon in (False, True):
+                expected = [record.getId() for record in catalog.subsetContaining(coord, includeValidPolygon)]
+                result = index.subsetContaining(coord, includeValidPolygon)
+                self.assertEqual([record.getId() for record in result], expected)
+            self.assertEqual([record.getId() for record in subset], expected)
+            found.update(recordId // 1000 for recordId in expected)
+        self.assertEqual(len(batched[-3]), 0)
+        # Make sure the queries actually hit records of every group.
+        self.assertEqual(found, {0, 1, 2, 3})
+        self.assertGreater(len(batched[-2]), 0)
+        self.assertGreater(len(batched[-1]), 0)
+
     def testCoaddInputs(self):
         coaddInputs = lsst.afw.image.CoaddInputs(
             lsst.afw.table.ExposureTable.makeMinimalSchema(),
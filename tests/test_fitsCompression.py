@@ -29,6 +29,7 @@ import astropy.io.fits
 
 import lsst.utils
 import lsst.daf.base
+import lsst.pex.exceptions
 import lsst.geom
 import lsst.afw.geom
 import lsst.afw.image
@@ -741,6 +742,7 @@ def optionsToPropertySet(options):
     ps.set("scaling.quantizePad", options.scaling.quantizePad)
     ps.set("scaling.bscale", options.scaling.bscale)
     ps.set("scaling.bzero", options.scaling.bzero)
+    ps.set("scaling.statsSamples", options.scaling.statsSamples)
     return ps
 
 
@@ -820,6 +822,157 @@ class PersistenceTestCase(ImageCompressionTestCase):
         return persistUnpersist(lsst.afw.image.MaskedImageF, image, filename, additionalData)
 
 
+class StatsSamplingTestCase(lsst.utils.tests.TestCase):
+    """Test estimating the STDEV_* scaling from a sample of pixels"""
+    def setUp(self):
+        self.mean = 1000.0
+        self.noise = 10.0
+        self.image = lsst.afw.image.ImageF(500, 400)
+        rng = np.random.RandomState(12345)
+        self.image.array[:] = rng.normal(self.mean, self.noise, self.image.array.shape)
+
+    def testEstimate(self):
+        numSamples = 10000
+        exact = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 16, quantizeLevel=4.0)
+        sampled = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 16, quantizeLevel=4.0,
+                                      statsSamples=numSamples)
+        self.assertEqual(sampled.statsSamples, numSamples)
+        exactScale = exact.determine(self.image)
+        sampledScale = sampled.determine(self.image)
+        # Five times the documented 1-sigma errors
+        self.assertFloatsAlmostEqual(sampledScale.bscale, exactScale.bscale, rtol=5*1.17/numSamples**0.5)
+        self.assertFloatsAlmostEqual(sampledScale.bzero, exactScale.bzero,
+                                     atol=5*1.25*self.noise/numSamples**0.5)
+        # Reproducible
+        self.assertEqual(sampled.determine(self.image).bscale, sampledScale.bscale)
+
+    def testMasked(self):
+        """Masked pixels are excluded from the sample; a mostly-masked image
+        falls back to the exact calculation."""
+        mask = lsst.afw.image.Mask(self.image.getBBox())
+        bad = mask.getPlaneBitMask("BAD")
+        mask.array[:, :100] = bad
+        self.image.array[:, :100] = 1.0e6
+        sampled = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 16, ["BAD"], statsSamples=10000)
+        scale = sampled.determine(self.image, mask)
+        self.assertFloatsAlmostEqual(scale.bscale, self.noise/4.0, rtol=0.05)
+
+        mask.array[:, :] = bad
+        mask.array[0, :200] = 0
+        exact = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 16, ["BAD"])
+        self.assertEqual(sampled.determine(self.image, mask).bscale, exact.determine(self.image, mask).bscale)
+
+
+class TiledReadTestCase(lsst.utils.tests.TestCase):
+    """Test reading subimages of tile-compressed images, serially and in
+    parallel.
+    """
+    def setUp(self):
+        self.bbox = lsst.geom.Box2I(lsst.geom.Point2I(-12, 34), lsst.geom.Extent2I(101, 93))
+        self.oldThreads = lsst.afw.fits.getImageReadThreads()
+
+    def tearDown(self):
+        lsst.afw.fits.setImageReadThreads(self.oldThreads)
+
+    def checkSubimages(self, ImageClass, options):
+        image = ImageClass(self.bbox)
+        rng = np.random.RandomState(12345)
+        image.array[:] = rng.randint(0, 1000, image.array.shape)
+        subBoxes = [lsst.geom.Box2I(),
+                    lsst.geom.Box2I(lsst.geom.Point2I(-12, 34), lsst.geom.Extent2I(1, 1)),
+                    lsst.geom.Box2I(lsst.geom.Point2I(5, 40), lsst.geom.Extent2I(10, 10)),
+                    lsst.geom.Box2I(lsst.geom.Point2I(-3, 47), lsst.geom.Extent2I(77, 61)),
+                    lsst.geom.Box2I(lsst.geom.Point2I(88, 35), lsst.geom.Extent2I(1, 92))]
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            image.writeFits(filename, options)
+            for nThreads, subBox in itertools.product((1, 2, 5, 64), subBoxes):
+                with self.subTest(nThreads=nThreads, subBox=subBox):
+                    lsst.afw.fits.setImageReadThreads(nThreads)
+                    expected = image if subBox.isEmpty() else image.subset(subBox)
+                    reader = lsst.afw.image.ImageFitsReader(filename)
+                    self.assertImagesEqual(reader.read(bbox=subBox, dtype=image.array.dtype), expected)
+
+    def testTiles(self):
+        """Test square-ish tiles that don't divide the image evenly"""
+        for algorithm in ("GZIP", "GZIP_SHUFFLE", "RICE"):
+            compression = ImageCompressionOptions(lsst.afw.fits.compressionAlgorithmFromString(algorithm),
+                                                  np.array([16, 7], dtype=np.int64))
+            self.checkSubimages(lsst.afw.image.ImageI, lsst.afw.fits.ImageWriteOptions(compression))
+
+    def testRows(self):
+        """Test the default tiling of one row per tile"""
+        compression = ImageCompressionOptions(ImageCompressionOptions.GZIP_SHUFFLE)
+        self.checkSubimages(lsst.afw.image.ImageF, lsst.afw.fits.ImageWriteOptions(compression))
+
+    def testUncompressed(self):
+        """Test that uncompressed images are unaffected"""
+        compression = ImageCompressionOptions(ImageCompressionOptions.NONE)
+        self.checkSubimages(lsst.afw.image.ImageD, lsst.afw.fits.ImageWriteOptions(compression))
+
+    def testInvalid(self):
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.fits.setImageReadThreads(0)
+
+
+class ParallelWriteTestCase(lsst.utils.tests.TestCase):
+    """Test that writing the planes of an Exposure concurrently produces the
+    same file as writing them serially.
+    """
+    def setUp(self):
+        self.oldThreads = lsst.afw.fits.getImageWriteThreads()
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(3, -7), lsst.geom.Extent2I(87, 65))
+        self.exposure = lsst.afw.image.ExposureF(bbox)
+        rng = np.random.RandomState(12345)
+        mi = self.exposure.maskedImage
+        mi.image.array[:] = rng.normal(100.0, 5.0, mi.image.array.shape)
+        mi.mask.array[:] = rng.randint(0, 4, mi.mask.array.shape)
+        mi.variance.array[:] = 25.0
+        cdMatrix = np.array([[1.0e-4, 0.0], [0.0, 1.0e-4]], dtype=float)
+        self.exposure.setWcs(lsst.afw.geom.makeSkyWcs(crval=lsst.geom.SpherePoint(0, 0, lsst.geom.degrees),
+                                                      crpix=lsst.geom.Point2D(0.0, 0.0),
+                                                      cdMatrix=cdMatrix))
+
+    def tearDown(self):
+        lsst.afw.fits.setImageWriteThreads(self.oldThreads)
+
+    def readBytes(self, nThreads, *options):
+        lsst.afw.fits.setImageWriteThreads(nThreads)
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            self.exposure.writeFits(filename, *options)
+            with open(filename, "rb") as f:
+                data = f.read()
+            readback = lsst.afw.image.ExposureF(filename)
+        return data, readback
+
+    def checkIdentical(self, *options):
+        expected, _ = self.readBytes(1, *options)
+        for nThreads in (2, 3, 8):
+            with self.subTest(nThreads=nThreads):
+                data, readback = self.readBytes(nThreads, *options)
+                self.assertEqual(data, expected)
+                self.assertEqual(readback.getWcs(), self.exposure.getWcs())
+                self.assertMasksEqual(readback.mask, self.exposure.mask)
+
+    def testDefault(self):
+        self.checkIdentical()
+
+    def testLossless(self):
+        compression = ImageCompressionOptions(ImageCompressionOptions.GZIP_SHUFFLE)
+        options = lsst.afw.fits.ImageWriteOptions(compression)
+        self.checkIdentical(options, options, options)
+
+    def testLossy(self):
+        compression = ImageCompressionOptions(ImageCompressionOptions.RICE, True, 0.0)
+        scaling = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 32, quantizeLevel=10.0)
+        imageOptions = lsst.afw.fits.ImageWriteOptions(compression, scaling)
+        maskOptions = lsst.afw.fits.ImageWriteOptions(compression)
+        self.checkIdentical(imageOptions, maskOptions, imageOptions)
+
+    def testInvalid(self):
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.fits.setImageWriteThreads(0)
+
+
 class EmptyExposureTestCase(lsst.utils.tests.TestCase):
     """Test that an empty image can be written
 
@@ -208,6 +208,83 @@ class ImagePcaTestCase(lsst.utils.tests.TestCase):
             afwDisplay.Display(frame=0).mtv(mos.makeMosaic(eImages), title="testPcaNaN")
 
 
+    def makeInputs(self, numInputs, width=30, height=20, ImageClass=afwImage.ImageF):
+        """Make images that are random combinations of a few smooth bases"""
+        rng = np.random.RandomState(12345)
+        y, x = np.indices((height, width))
+        bases = [np.exp(-0.5*((x - 15)**2 + (y - 10)**2)/(2.0 + i)**2) for i in range(3)]
+        inputs = []
+        for i in range(numInputs):
+            im = ImageClass(width, height)
+            array = sum(rng.uniform(0.5, 1.5)*b for b in bases) + 0.01*rng.randn(height, width)
+            if ImageClass is afwImage.MaskedImageF:
+                im.image.array[:, :] = array
+                im.variance.array[:, :] = rng.uniform(1.0, 2.0, array.shape)
+                im.mask.array[i % height, i % width] = 1 << (i % 3)
+            else:
+                im.array[:, :] = array
+            inputs.append((im, rng.uniform(1.0, 10.0)))
+        return inputs
+
+    def assertPcaEqual(self, pca1, pca2):
+        np.testing.assert_allclose(pca1.getEigenValues(), pca2.getEigenValues(), rtol=1e-6, atol=1e-12)
+        eImages1 = pca1.getEigenImages()
+        eImages2 = pca2.getEigenImages()
+        self.assertEqual(len(eImages1), len(eImages2))
+        # eigenvectors are only defined up to a sign; just check the leading (well-separated) ones
+        for im1, im2 in list(zip(eImages1, eImages2))[:2]:
+            sign = np.sign(np.sum(im1.array*im2.array))
+            self.assertFloatsAlmostEqual(im1.array, sign*im2.array, rtol=1e-5, atol=1e-8)
+
+    def testIncremental(self):
+        """Test that adding images between calls to analyze in incremental
+        mode gives the same answer as analyzing them all at once"""
+        for constantWeight in (True, False):
+            inputs = self.makeInputs(12)
+            direct = afwImage.ImagePcaF(constantWeight)
+            for im, flux in inputs:
+                direct.addImage(im, flux)
+            direct.analyze()
+
+            incremental = afwImage.ImagePcaF(constantWeight)
+            self.assertFalse(incremental.isIncremental())
+            incremental.setIncremental(True)
+            self.assertTrue(incremental.isIncremental())
+            for start, stop in ((0, 5), (5, 6), (6, 12)):
+                for im, flux in inputs[start:stop]:
+                    incremental.addImage(im, flux)
+                incremental.analyze()
+            self.assertPcaEqual(incremental, direct)
+
+    def testEigenImages(self):
+        """Test the eigenimages (including the mask and variance planes of
+        MaskedImages) against summing scaled input images"""
+        inputs = self.makeInputs(6, ImageClass=afwImage.MaskedImageF)
+        pca = afwImage.ImagePcaMF(True)
+        for im, flux in inputs:
+            pca.addImage(im, flux)
+        pca.analyze()
+        eImages = pca.getEigenImages()
+        self.assertEqual(len(eImages), len(inputs))
+
+        fluxes = np.array([flux for _, flux in inputs])
+        images = np.array([im.image.array/flux for im, flux in inputs]).reshape(len(inputs), -1)
+        gram = images.dot(images.T)/len(inputs)
+        eigenValues, eigenVectors = np.linalg.eigh(gram)
+        order = np.argsort(eigenValues)[::-1]
+        np.testing.assert_allclose(pca.getEigenValues(), eigenValues[order], rtol=1e-6, atol=1e-12)
+
+        expectedMask = np.bitwise_or.reduce([im.mask.array for im, _ in inputs])
+        for i, eImage in enumerate(eImages[:2]):
+            weights = eigenVectors[:, order[i]]*fluxes.mean()/fluxes
+            expected = sum(w*im.image.array for w, (im, _) in zip(weights, inputs))
+            expectedVariance = sum(w**2*im.variance.array for w, (im, _) in zip(weights, inputs))
+            sign = np.sign(np.sum(expected*eImage.image.array))
+            self.assertFloatsAlmostEqual(eImage.image.array, sign*expected, rtol=1e-4, atol=1e-6)
+            self.assertFloatsAlmostEqual(eImage.variance.array, expectedVariance, rtol=1e-4)
+            np.testing.assert_array_equal(eImage.mask.array, expectedMask)
+
+
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
 
@@ -236,6 +236,45 @@ class TransformImageTestCase(unittest.TestCase):
         # for a while, swig couldn't handle the resulting std::shared_ptr<Mask>
         afwMath.flipImage(mask, True, False)
 
+    def makeMaskedImage(self, width, height):
+        rng = np.random.RandomState(7)
+        image = afwImage.MaskedImageF(width, height)
+        image.image.array[:, :] = rng.randn(height, width)
+        image.mask.array[:, :] = rng.randint(0, 256, (height, width))
+        image.variance.array[:, :] = rng.uniform(1.0, 2.0, (height, width))
+        return image
+
+    def testRotateArrays(self):
+        """Test rotating images larger than, and not multiples of, the tiles
+        used for quarter turns."""
+        inImage = self.makeMaskedImage(101, 67)
+        for nQuarter in range(-1, 5):
+            outImage = afwMath.rotateImageBy90(inImage, nQuarter)
+            for inArray, outArray in zip(inImage.getArrays(), outImage.getArrays()):
+                np.testing.assert_array_equal(outArray, np.rot90(inArray, -nQuarter))
+
+    def testFlipInPlace(self):
+        """Test flipping images in place."""
+        for width, height in [(33, 17), (32, 16), (1, 1)]:
+            for flipLR in (False, True):
+                for flipTB in (False, True):
+                    image = self.makeMaskedImage(width, height)
+                    expected = afwMath.flipImage(image, flipLR, flipTB)
+                    arrays = [array.copy() for array in image.getArrays()]
+                    view = image[:, :]
+                    afwMath.flipImageInPlace(view, flipLR, flipTB)
+                    for array, flipped in zip(arrays, image.getArrays()):
+                        np.testing.assert_array_equal(
+                            flipped, array[slice(None, None, -1 if flipTB else 1),
+                                           slice(None, None, -1 if flipLR else 1)])
+                    for flipped, expectedArray in zip(image.getArrays(), expected.getArrays()):
+                        np.testing.assert_array_equal(flipped, expectedArray)
+
+        mask = afwImage.Mask(10, 20)
+        mask.array[0, 0] = 1
+        afwMath.flipImageInPlace(mask, True, True)
+        self.assertEqual(mask.array[19, 9], 1)
+
 
 class BinImageTestCase(unittest.TestCase):
     """A test case for binning images.
@@ -291,6 +330,84 @@ class BinImageTestCase(unittest.TestCase):
             afwDisplay.Display(frame=2).mtv(inImage, title="unbinned")
             afwDisplay.Display(frame=3).mtv(outImage, title=f"binned {binX}x{binY}")
 
+    @staticmethod
+    def binArray(array, binX, binY, op=np.mean):
+        """Bin a numpy array the way binImage should"""
+        height, width = array.shape[0]//binY, array.shape[1]//binX
+        blocks = array[:height*binY, :width*binX].reshape(height, binY, width, binX)
+        return op(op(blocks, axis=3), axis=1)
+
+    def testBinMaskedImage(self):
+        """Test binning each plane of a MaskedImage"""
+        rng = np.random.RandomState(12)
+        inImage = afwImage.MaskedImageF(lsst.geom.Box2I(lsst.geom.Point2I(5, -7),
+                                                        lsst.geom.Extent2I(203, 131)))
+        inImage.image.array[:, :] = rng.randn(131, 203)
+        inImage.variance.array[:, :] = rng.uniform(1.0, 2.0, (131, 203))
+        inImage.mask.array[:, :] = 1 << rng.randint(0, 4, (131, 203))
+        binX, binY = 3, 4
+
+        outImage = afwMath.binImage(inImage, binX, binY)
+
+        self.assertEqual(outImage.getXY0(), inImage.getXY0())
+        np.testing.assert_allclose(outImage.image.array, self.binArray(inImage.image.array, binX, binY),
+                                   rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(outImage.variance.array,
+                                   self.binArray(inImage.variance.array, binX, binY)/(binX*binY), rtol=1e-6)
+        np.testing.assert_array_equal(outImage.mask.array,
+                                      self.binArray(inImage.mask.array, binX, binY, np.bitwise_or.reduce))
+
+    def testBinInteger(self):
+        """Test that integer images are binned without overflow and with truncation"""
+        inImage = afwImage.ImageU(8, 6)
+        inImage.array[:, :] = 60000
+        inImage.array[0, 0] = 59999
+        outImage = afwMath.binImage(inImage, 2)
+        self.assertEqual(outImage.array[0, 0], 59999)
+        np.testing.assert_array_equal(outImage.array.flatten()[1:], 60000)
+
+        # Bin areas whose reciprocals are inexact must still divide exact sums exactly.
+        for ImageClass in (afwImage.ImageU, afwImage.ImageI):
+            for binSize in (7, 14):
+                with self.subTest(ImageClass=ImageClass, binSize=binSize):
+                    inImage = ImageClass(2*binSize, binSize)
+                    inImage.array[:, :] = 1
+                    outImage = afwMath.binImage(inImage, binSize)
+                    np.testing.assert_array_equal(outImage.array, 1)
+        inImage = afwImage.ImageI(14, 7)
+        inImage.array[:, :7] = -1
+        inImage.array[:, 7:] = -2
+        inImage.array[0, 7] = -1
+        outImage = afwMath.binImage(inImage, 7)
+        # -97/49 truncates towards zero, as integer division does.
+        np.testing.assert_array_equal(outImage.array, [[-1, -1]])
+
+    def testPyramid(self):
+        """Test that a pyramid matches binning by each factor"""
+        rng = np.random.RandomState(3)
+        for ImageClass in (afwImage.ImageI, afwImage.ImageF, afwImage.MaskedImageF):
+            with self.subTest(ImageClass=ImageClass):
+                inImage = ImageClass(lsst.geom.Box2I(lsst.geom.Point2I(-3, 11), lsst.geom.Extent2I(203, 131)))
+                if ImageClass is afwImage.MaskedImageF:
+                    inImage.image.array[:, :] = rng.randn(131, 203)
+                    inImage.variance.array[:, :] = rng.uniform(1.0, 2.0, (131, 203))
+                    inImage.mask.array[:, :] = 1 << rng.randint(0, 4, (131, 203))
+                else:
+                    inImage.array[:, :] = rng.randint(-1000, 1000, (131, 203))
+                pyramid = afwMath.binImagePyramid(inImage, 5)
+                self.assertEqual(len(pyramid), 5)
+                for i, level in enumerate(pyramid):
+                    expected = afwMath.binImage(inImage, 2**(i + 1))
+                    self.assertEqual(level.getBBox(), expected.getBBox())
+                    if ImageClass is afwImage.MaskedImageF:
+                        np.testing.assert_allclose(level.image.array, expected.image.array, atol=1e-6)
+                        np.testing.assert_allclose(level.variance.array, expected.variance.array, rtol=1e-6)
+                        np.testing.assert_array_equal(level.mask.array, expected.mask.array)
+                    elif ImageClass is afwImage.ImageI:
+                        np.testing.assert_array_equal(level.array, expected.array)
+                    else:
+                        np.testing.assert_allclose(level.array, expected.array, rtol=1e-6)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
@@ -273,6 +273,16 @@ class PhotoCalibTestCase(lsst.utils.tests.TestCase):
         result = photoCalib.instFluxToMagnitude(catalog, self.instFluxKeyName)
         self.assertFloatsAlmostEqual(expectMag, result)
 
+        # records that are not contiguous in memory go through a different code path
+        reordered = lsst.afw.table.SourceCatalog(catalog.table)
+        for record in reversed(catalog):
+            reordered.append(record)
+        self.assertEqual(reordered.isContiguous(), len(catalog) < 2)
+        result = photoCalib.instFluxToNanojansky(reordered, self.instFluxKeyName)
+        self.assertFloatsAlmostEqual(expectNanojansky[::-1], result)
+        result = photoCalib.calibrateCatalog(reordered)
+        self.assertFloatsAlmostEqual(result[self.instFluxKeyName + '_flux'], expectNanojansky[::-1, 0])
+
         # Test modifying the catalog in-place with instFluxToNanojansky/instFluxToMagnitude
         # The original instFluxes shouldn't change: save them to test that.
         origInstFlux = catalog[self.instFluxKeyName+'_instFlux'].copy()
@@ -596,6 +606,28 @@ class PhotoCalibTestCase(lsst.utils.tests.TestCase):
         result = photoCalib.calibrateImage(maskedImage, includeScaleUncertainty=False)
         self.assertMaskedImagesAlmostEqual(expect, result)
 
+    def testCalibrateImageInPlace(self):
+        """Test that calibrating in place matches calibrateImage."""
+        for calibration in (self.calibration, self.linearXCalibration):
+            for includeScaleUncertainty in (True, False):
+                npDim, maskedImage, image, mask, variance = self.setupImage()
+                photoCalib = lsst.afw.image.PhotoCalib(calibration, self.calibrationErr)
+                expect = photoCalib.calibrateImage(maskedImage, includeScaleUncertainty)
+                photoCalib.calibrateImageInPlace(maskedImage, includeScaleUncertainty)
+                self.assertMaskedImagesAlmostEqual(expect, maskedImage)
+
+        # pixels outside the domain of the calibration are not scaled
+        npDim, maskedImage, image, mask, variance = self.setupImage()
+        photoCalib = lsst.afw.image.PhotoCalib(self.linearXCalibration, self.calibrationErr)
+        maskedImage.setXY0(lsst.geom.Point2I(98, 98))
+        original = maskedImage.clone()
+        photoCalib.calibrateImageInPlace(maskedImage, includeScaleUncertainty=False)
+        self.assertFloatsEqual(maskedImage.image.array[:3, 3:], original.image.array[:3, 3:])
+        self.assertFloatsEqual(maskedImage.variance.array[:3, 3:], original.variance.array[:3, 3:])
+        self.assertFloatsEqual(maskedImage.image.array[3:, :], original.image.array[3:, :])
+        self.assertFloatsAlmostEqual(maskedImage.image.array[:3, :3],
+                                     original.image.array[:3, :3]*self.calibration, rtol=1E-6)
+
     def testNonPositiveMeans(self):
         # no negative calibrations
         with(self.assertRaises(lsst.pex.exceptions.InvalidParameterError)):
@@ -26,6 +26,7 @@ import numpy as np
 
 import lsst.utils.tests
 import lsst.geom
+import lsst.pex.exceptions
 import lsst.afw.geom as afwGeom
 import lsst.afw.image  # noqa: F401 required by Polygon.createImage
 
@@ -147,6 +148,20 @@ class PolygonTest(lsst.utils.tests.TestCase):
             self.assertFalse(poly.contains(
                 lsst.geom.Point2D(self.x0 + radius, self.y0 + radius)))
 
+    def testContainsArrays(self):
+        """Test Polygon.contains with arrays of points"""
+        rng = np.random.RandomState(12345)
+        x = rng.uniform(-2.0, 2.0, 1000)
+        y = rng.uniform(-2.0, 2.0, 1000)
+        concave = afwGeom.Polygon([lsst.geom.Point2D(*xy) for xy in
+                                   ((-1.5, -1.5), (1.5, -1.2), (0.0, 0.1), (1.4, 1.6), (-1.3, 1.0))])
+        for poly in [self.polygon(num, radius=1.5) for num in (3, 4, 7, 30)] + [concave]:
+            expected = [poly.contains(lsst.geom.Point2D(xx, yy)) for xx, yy in zip(x, y)]
+            np.testing.assert_array_equal(poly.contains(x, y), expected)
+            np.testing.assert_array_equal(poly.contains(x[::3], y[::3]), expected[::3])
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            concave.contains(x, y[:-1])
+
     def testOverlaps(self):
         """Test Polygon.overlaps"""
         radius = 1.0
@@ -272,10 +287,25 @@ class PolygonTest(lsst.utils.tests.TestCase):
                     disp.mtv(image, title=f"Polygon nside={num}")
                     for p1, p2 in poly.getEdges():
                         disp.line((p1, p2))
-                # Some computations of the image area have such large aliasing
-                # in boost::intersection that the precision required here is 0.025.
                 self.assertFloatsAlmostEqual(
-                    image.getArray().sum(), poly.calculateArea(), rtol=0.025)
+                    image.getArray().sum(), poly.calculateArea(), rtol=1.0E-5)
+
+    def testImagePixels(self):
+        """Test that Polygon.createImage gives the overlap with each pixel"""
+        concave = afwGeom.Polygon([lsst.geom.Point2D(*xy) for xy in
+                                   ((0.2, 0.3), (7.7, 1.1), (3.1, 3.4), (8.2, 9.6), (1.3, 6.6))])
+        for poly in (concave, self.polygon(7, 4.3, 4.1, 3.9), self.square(2.5, 3.25, 5.0)):
+            # The box clips the polygons on two sides
+            box = lsst.geom.Box2I(lsst.geom.Point2I(1, -1), lsst.geom.Extent2I(7, 9))
+            image = poly.createImage(box)
+            self.assertEqual(image.getBBox(), box)
+            for y in range(box.getMinY(), box.getMaxY() + 1):
+                for x in range(box.getMinX(), box.getMaxX() + 1):
+                    pixel = lsst.geom.Box2D(lsst.geom.Point2D(x - 0.5, y - 0.5),
+                                            lsst.geom.Point2D(x + 0.5, y + 0.5))
+                    expected = sum(p.calculateArea() for p in poly.intersection(pixel))
+                    self.assertFloatsAlmostEqual(image[x, y, lsst.afw.image.PARENT], expected,
+                                                 atol=1.0E-6, msg=f"pixel {x},{y}")
 
     def testTransform(self):
         """Test constructor for Polygon involving transforms"""
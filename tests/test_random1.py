@@ -33,6 +33,8 @@ import sys
 import time
 import unittest
 
+import numpy as np
+
 import lsst.pex.exceptions
 import lsst.utils.tests
 import lsst.geom
@@ -141,6 +143,82 @@ class RandomImageTestCase(unittest.TestCase):
         self.assertAlmostEqual(stats.getValue(afwMath.VARIANCE), mu, 1)
 
 
+class CounterRandomImageTestCase(lsst.utils.tests.TestCase):
+    """A test case for the counter-based random image functions"""
+
+    def setUp(self):
+        self.bbox = lsst.geom.Box2I(lsst.geom.Point2I(-20, 30), lsst.geom.Extent2I(500, 400))
+        self.seed = 98765
+
+    def testReproducible(self):
+        """Test that the pixels depend only on the seed and position"""
+        fills = [
+            lambda image, nThreads: afwMath.randomUniformImage(image, self.seed, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomUniformPosImage(image, self.seed, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomUniformIntImage(image, self.seed, 7, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomFlatImage(image, self.seed, -2.0, 3.0, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomGaussianImage(image, self.seed, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomChisqImage(image, self.seed, 3.0, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomPoissonImage(image, self.seed, 4.0, nThreads=nThreads),
+            lambda image, nThreads: afwMath.randomPoissonImage(image, self.seed, 200.0, nThreads=nThreads),
+        ]
+        subBBox = lsst.geom.Box2I(lsst.geom.Point2I(100, 50), lsst.geom.Extent2I(37, 101))
+        for i, fill in enumerate(fills):
+            with self.subTest(i=i):
+                image = afwImage.ImageD(self.bbox)
+                fill(image, 1)
+                self.assertGreater(len(np.unique(image.array)), 1)
+                threaded = afwImage.ImageD(self.bbox)
+                fill(threaded, 7)
+                self.assertImagesEqual(threaded, image)
+                sub = afwImage.ImageD(subBBox)
+                fill(sub, 2)
+                self.assertImagesEqual(sub, image[subBBox])
+
+        image = afwImage.ImageF(self.bbox)
+        afwMath.randomGaussianImage(image, self.seed)
+        other = afwImage.ImageF(self.bbox)
+        afwMath.randomGaussianImage(other, self.seed + 1)
+        self.assertLess(np.mean(image.array == other.array), 0.01)
+
+    def testDistributions(self):
+        image = afwImage.ImageD(self.bbox)
+        n = image.array.size
+
+        afwMath.randomUniformImage(image, self.seed)
+        self.assertGreaterEqual(image.array.min(), 0.0)
+        self.assertLess(image.array.max(), 1.0)
+        self.assertFloatsAlmostEqual(image.array.mean(), 0.5, atol=5/np.sqrt(12*n))
+
+        afwMath.randomUniformIntImage(image, self.seed, 5)
+        np.testing.assert_array_equal(np.unique(image.array), np.arange(5))
+
+        afwMath.randomGaussianImage(image, self.seed)
+        self.assertFloatsAlmostEqual(image.array.mean(), 0.0, atol=5/np.sqrt(n))
+        self.assertFloatsAlmostEqual(image.array.var(), 1.0, atol=5*np.sqrt(2/n))
+
+        for nu in (0.5, 3.0, 10.0):
+            afwMath.randomChisqImage(image, self.seed, nu)
+            self.assertFloatsAlmostEqual(image.array.mean(), nu, atol=5*np.sqrt(2*nu/n))
+
+        for mu in (0.0, 3.5, 9.9, 10.0, 1000.0):
+            afwMath.randomPoissonImage(image, self.seed, mu)
+            np.testing.assert_array_equal(image.array, np.round(image.array))
+            self.assertFloatsAlmostEqual(image.array.mean(), mu, atol=5*np.sqrt(mu/n) + 1e-12)
+            self.assertFloatsAlmostEqual(image.array.var(), mu, atol=5*mu*np.sqrt(2/n) + 1e-12)
+
+    def testErrors(self):
+        image = afwImage.ImageF(self.bbox)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.randomGaussianImage(image, self.seed, nThreads=0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.randomPoissonImage(image, self.seed, -1.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.randomChisqImage(image, self.seed, 0.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.randomUniformIntImage(image, self.seed, 0)
+
+
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
 
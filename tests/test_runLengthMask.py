@@ -0,0 +1,121 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import unittest
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.geom
+import lsst.pex.exceptions
+import lsst.afw.geom as afwGeom
+import lsst.afw.image as afwImage
+
+
+class RunLengthMaskTestCase(lsst.utils.tests.TestCase):
+
+    def setUp(self):
+        np.random.seed(1)
+        self.bbox = lsst.geom.Box2I(lsst.geom.Point2I(5, -3), lsst.geom.Extent2I(40, 30))
+        self.mask = afwImage.Mask(self.bbox)
+        self.crBit = afwImage.Mask.getPlaneBitMask("CR")
+        self.satBit = afwImage.Mask.getPlaneBitMask("SAT")
+        self.mask.array[:, :] = np.where(np.random.rand(30, 40) < 0.1, self.crBit, 0)
+        self.mask.array[10:20, 3:9] |= self.satBit
+        # The highest bit must survive compression too.
+        self.mask.array[2, :] |= np.int32(-2**31)
+
+    def testRoundTrip(self):
+        compressed = afwImage.RunLengthMask(self.mask)
+        self.assertEqual(compressed.getBBox(), self.bbox)
+        self.assertEqual(compressed.getMaskPlaneDict(), self.mask.getMaskPlaneDict())
+        self.assertEqual(compressed.getPlaneBitMask("CR"), self.crBit)
+        restored = compressed.toMask()
+        self.assertEqual(restored.getBBox(), self.bbox)
+        np.testing.assert_array_equal(restored.array, self.mask.array)
+        self.assertEqual(compressed, afwImage.RunLengthMask(restored))
+        point = lsst.geom.Point2I(10, 9)
+        self.assertEqual(compressed.get(point), self.mask[point])
+        self.assertEqual(compressed.get(lsst.geom.Point2I(0, 0)), 0)
+
+    def testPlaneQueries(self):
+        compressed = afwImage.RunLengthMask(self.mask)
+        self.assertTrue(compressed.any(self.satBit))
+        self.assertFalse(compressed.any(afwImage.Mask.getPlaneBitMask("EDGE")))
+        self.assertEqual(compressed.getUsedBits() & (self.crBit | self.satBit), self.crBit | self.satBit)
+        spans = compressed.getSpanSet(self.satBit)
+        self.assertEqual(spans.getArea(), 60)
+        self.assertEqual(spans, afwGeom.SpanSet.fromMask(self.mask, self.satBit))
+        # The saturated block is one run on each of its 10 rows.
+        compressed &= self.satBit
+        self.assertEqual(compressed.getNumSpans(), 10)
+
+    def testBitwiseOperators(self):
+        other = afwImage.Mask(self.bbox)
+        other.array[5:25, 10:30] = self.crBit | self.satBit
+        for op in ("__ior__", "__iand__"):
+            expected = afwImage.Mask(self.mask, deep=True)
+            getattr(expected, op)(other)
+            compressed = afwImage.RunLengthMask(self.mask)
+            compressed = getattr(compressed, op)(afwImage.RunLengthMask(other))
+            np.testing.assert_array_equal(compressed.toMask().array, expected.array)
+
+        compressed = afwImage.RunLengthMask(self.mask)
+        compressed &= self.satBit
+        self.assertEqual(compressed.getUsedBits(), self.satBit)
+        compressed |= self.crBit
+        self.assertEqual(compressed.getSpanSet(self.crBit).getArea(), self.bbox.getArea())
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            compressed |= afwImage.RunLengthMask(lsst.geom.Box2I(self.bbox.getMin(),
+                                                                 lsst.geom.Extent2I(3, 3)))
+
+    def testSpanSetInterop(self):
+        spans = afwGeom.SpanSet.fromShape(4, afwGeom.Stencil.CIRCLE, offset=(20, 10))
+        compressed = afwImage.RunLengthMask(self.mask)
+        spans.setMask(compressed, self.satBit)
+        spans.setMask(self.mask, self.satBit)
+        np.testing.assert_array_equal(compressed.toMask().array, self.mask.array)
+        self.assertEqual(spans.intersect(compressed, self.crBit), spans.intersect(self.mask, self.crBit))
+        self.assertEqual(spans.intersectNot(compressed, self.crBit),
+                         spans.intersectNot(self.mask, self.crBit))
+        self.assertEqual(spans.union(compressed, self.crBit), spans.union(self.mask, self.crBit))
+
+        spans.clearMask(compressed, self.satBit)
+        spans.clearMask(self.mask, self.satBit)
+        np.testing.assert_array_equal(compressed.toMask().array, self.mask.array)
+
+        outside = afwGeom.SpanSet(lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(100, 100)))
+        with self.assertRaises(lsst.pex.exceptions.OutOfRangeError):
+            outside.setMask(compressed, self.satBit)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -161,6 +161,17 @@ class SchemaTestCase(unittest.TestCase):
         self.assertNotIn(otherKey, schema)
         self.assertNotEqual(keys[0], keys[1])
 
+    def testFindKeys(self):
+        schema = lsst.afw.table.Schema()
+        ka = schema.addField("a_x", type=np.float64)
+        kb = schema.addField("a_flag", type="Flag")
+        kc = schema.addField("c", type="ArrayF", size=3)
+        schema.getAliasMap().set("b", "a")
+        self.assertEqual(schema.findKeys(["c", "b_flag", "a_x"]), [kc, kb, ka])
+        self.assertEqual(schema.findKeys([]), [])
+        with self.assertRaises(KeyError):
+            schema.findKeys(["a_x", "d"])
+
     def testKeyAccessors(self):
         schema = lsst.afw.table.Schema()
         arrayKey = schema.addField(
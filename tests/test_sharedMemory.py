@@ -0,0 +1,155 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import multiprocessing
+import os
+import tempfile
+import unittest
+import uuid
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.geom
+import lsst.pex.exceptions
+import lsst.afw.image as afwImage
+
+
+def sumSharedMaskedImage(name):
+    """Attach to a shared MaskedImageF in a worker process and sum its planes.
+    """
+    mi = afwImage.MaskedImageF.attachShared(name)
+    return (float(mi.image.array.sum()), int(mi.mask.array.sum()), float(mi.variance.array.sum()),
+            mi.getBBox())
+
+
+def writeSharedImage(name, value):
+    """Attach writeable to a shared ImageF in a worker process and fill it.
+    """
+    image = afwImage.ImageF.attachShared(name, readOnly=False)
+    image.array[:, :] = value
+
+
+class SharedMemoryTestCase(lsst.utils.tests.TestCase):
+
+    def setUp(self):
+        self.bbox = lsst.geom.Box2I(lsst.geom.Point2I(12, -3), lsst.geom.Extent2I(31, 17))
+        self.name = "/afw-test-%d-%s" % (os.getpid(), uuid.uuid4().hex[:8])
+        rng = np.random.RandomState(5)
+        self.pattern = rng.randn(self.bbox.getHeight(), self.bbox.getWidth())
+
+    def tearDown(self):
+        try:
+            afwImage.unlinkSharedMemory(self.name)
+        except lsst.pex.exceptions.IoError:
+            pass
+
+    def testImage(self):
+        for Image in (afwImage.ImageU, afwImage.ImageI, afwImage.ImageF, afwImage.ImageD,
+                      afwImage.ImageL):
+            with self.subTest(Image=Image):
+                image = Image.makeShared(self.name, self.bbox)
+                self.assertEqual(image.getBBox(), self.bbox)
+                np.testing.assert_array_equal(image.array, 0)
+                image.array[:, :] = np.abs(self.pattern*100)
+                attached = Image.attachShared(self.name)
+                self.assertEqual(attached.getBBox(), self.bbox)
+                self.assertImagesEqual(attached, image)
+                afwImage.unlinkSharedMemory(self.name)
+
+    def testMask(self):
+        mask = afwImage.Mask.makeShared(self.name, self.bbox)
+        mask.array[:, :] = (self.pattern > 0)*mask.getPlaneBitMask("DETECTED")
+        attached = afwImage.Mask.attachShared(self.name)
+        self.assertMasksEqual(attached, mask)
+
+    def testReadOnlyIsCopyOnWrite(self):
+        image = afwImage.ImageF.makeShared(self.name, self.bbox)
+        image.array[:, :] = 1.0
+        attached = afwImage.ImageF.attachShared(self.name)
+        attached.array[:, :] = 2.0
+        np.testing.assert_array_equal(image.array, 1.0)
+        writeable = afwImage.ImageF.attachShared(self.name, readOnly=False)
+        writeable.array[:, :] = 3.0
+        np.testing.assert_array_equal(image.array, 3.0)
+
+    def testWrongType(self):
+        afwImage.MaskedImageF.makeShared(self.name, self.bbox)
+        with self.assertRaises(lsst.pex.exceptions.TypeError):
+            afwImage.MaskedImageD.attachShared(self.name)
+        with self.assertRaises(lsst.pex.exceptions.TypeError):
+            afwImage.ImageF.attachShared(self.name)
+
+    def testExistingName(self):
+        afwImage.ImageF.makeShared(self.name, self.bbox)
+        with self.assertRaises(lsst.pex.exceptions.IoError):
+            afwImage.ImageF.makeShared(self.name, self.bbox)
+
+    def testMissingName(self):
+        with self.assertRaises(lsst.pex.exceptions.IoError):
+            afwImage.ImageF.attachShared(self.name)
+
+    def testFileBacked(self):
+        with tempfile.TemporaryDirectory() as tempDir:
+            filename = os.path.join(tempDir, "shared.img")
+            mi = afwImage.MaskedImageD.makeShared(filename, self.bbox)
+            mi.image.array[:, :] = self.pattern
+            mi.variance.array[:, :] = 2.0
+            attached = afwImage.MaskedImageD.attachShared(filename)
+            self.assertMaskedImagesEqual(attached, mi)
+            afwImage.unlinkSharedMemory(filename)
+            # existing attachments survive unlinking
+            self.assertMaskedImagesEqual(attached, mi)
+
+    def testMultiprocess(self):
+        mi = afwImage.MaskedImageF.makeShared(self.name, self.bbox)
+        mi.image.array[:, :] = self.pattern
+        mi.mask.array[:, :] = 1
+        mi.variance.array[:, :] = 0.5
+        expected = (float(mi.image.array.sum()), int(mi.mask.array.sum()), float(mi.variance.array.sum()),
+                    self.bbox)
+        context = multiprocessing.get_context("fork")
+        with context.Pool(2) as pool:
+            for result in pool.map(sumSharedMaskedImage, [self.name]*4):
+                self.assertFloatsAlmostEqual(result[0], expected[0], rtol=1E-6)
+                self.assertEqual(result[1:], expected[1:])
+
+        image = afwImage.ImageF.makeShared(self.name + "-2", self.bbox)
+        try:
+            process = context.Process(target=writeSharedImage, args=(self.name + "-2", 4.0))
+            process.start()
+            process.join()
+            np.testing.assert_array_equal(image.array, 4.0)
+        finally:
+            afwImage.unlinkSharedMemory(self.name + "-2")
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -428,6 +428,37 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         cat8.extend(list(cat7), True)
         cat8.extend(list(cat7), deep=True)
 
+    def testMakeContiguous(self):
+        schema = lsst.afw.table.Schema()
+        k1 = schema.addField("f1", type=np.int32)
+        k2 = schema.addField("f2", type="ArrayD", size=0)
+        k3 = schema.addField("f3", type="Flag")
+        cat1 = lsst.afw.table.BaseCatalog(schema)
+        for i in range(250):
+            record = cat1.addNew()
+            record.set(k1, i)
+            record.set(k2, np.arange(i % 5, dtype=float))
+            record.set(k3, i % 3 == 0)
+        cat2 = lsst.afw.table.BaseCatalog(schema)
+        cat2.extend(cat1, deep=True)
+        cat1.extend(cat2, deep=False)
+        cat1.sort(k1)
+        self.assertFalse(cat1.isContiguous())
+        records = list(cat1)
+        cat1.makeContiguous()
+        self.assertTrue(cat1.isContiguous())
+        self.assertEqual(list(cat1), records)
+        np.testing.assert_array_equal(cat1[k1], np.repeat(np.arange(250), 2))
+        np.testing.assert_array_equal(cat1["f3"], np.repeat(np.arange(250) % 3 == 0, 2))
+        for record in cat1:
+            np.testing.assert_array_equal(record.get(k2), np.arange(record.get(k1) % 5, dtype=float))
+        # Records were moved, not copied, so shallow copies see changes made through the column view.
+        cat1[k1] = np.arange(500)
+        self.assertEqual([record.get(k1) for record in cat2], list(range(1, 500, 2)))
+        cat1.append(cat1[0])
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            cat1.makeContiguous()
+
     def testTicket2308(self):
         inputSchema = lsst.afw.table.SourceTable.makeMinimalSchema()
         mapper1 = lsst.afw.table.SchemaMapper(inputSchema)
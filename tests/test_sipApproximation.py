@@ -524,6 +524,26 @@ class SipApproximationTestCases(lsst.utils.tests.TestCase):
         run(self.calexp03, order=3)
         run(self.wcs22, order=8)
 
+    def testRefit(self):
+        """Check that refitting on the same or a new grid gives the same
+        results as fitting from scratch.
+        """
+        kwds = extractCtorArgs(self.calexp03)
+        approx = SipApproximation(gridShape=Extent2I(12, 15), order=2, **kwds)
+        approx.fit(3)
+        approx.fit(3, 1E-12)
+        expected = SipApproximation(gridShape=Extent2I(12, 15), order=3, svdThreshold=1E-12, **kwds)
+        for getter in ("getA", "getB", "getAP", "getBP"):
+            assert_allclose(getattr(approx, getter)(), getattr(expected, getter)(), rtol=1E-12, atol=1E-15)
+        self.assertFloatsAlmostEqual(np.array(approx.computeMaxDeviation()),
+                                     np.array(expected.computeMaxDeviation()), rtol=1E-10)
+
+        approx.refineGrid(2)
+        approx.fit(3)
+        expected = SipApproximation(gridShape=approx.getGridShape(), order=3, **kwds)
+        for getter in ("getA", "getB", "getAP", "getBP"):
+            assert_allclose(getattr(approx, getter)(), getattr(expected, getter)(), rtol=1E-12, atol=1E-15)
+
     def testCalculateSipWcsHeader(self):
         """Test the calculateSipWcsHeader function
 
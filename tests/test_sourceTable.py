@@ -277,6 +277,41 @@ class SourceTableTestCase(lsst.utils.tests.TestCase):
             with self.assertRaises(lsst.pex.exceptions.LogicError):
                 getattr(self.catalog, f"get{quantity}")()
 
+    def testSlotColumns(self):
+        self.table.definePsfFlux("a")
+        self.table.defineCentroid("b")
+        self.table.defineShape("c")
+        self.table.definePsfShape("d")
+        for i, record in enumerate(self.catalog):
+            record.set(self.psfShapeFlagKey, i % 3 == 0)
+        # Records in reverse order are not contiguous in memory.
+        catalog = lsst.afw.table.SourceCatalog(self.table)
+        for record in reversed(self.catalog):
+            catalog.append(record)
+        self.assertFalse(catalog.isContiguous())
+        for cat in (self.catalog, catalog):
+            expected = [cat[i] for i in range(len(cat))]
+            self.assertFloatsEqual(cat.getPsfInstFlux(), [r.getPsfInstFlux() for r in expected])
+            self.assertFloatsEqual(cat.getPsfInstFluxErr(), [r.getPsfInstFluxErr() for r in expected])
+            np.testing.assert_array_equal(cat.getPsfFluxFlag(), [r.getPsfFluxFlag() for r in expected])
+            self.assertFloatsEqual(cat.getX(), [r.getX() for r in expected])
+            self.assertFloatsEqual(cat.getY(), [r.getY() for r in expected])
+            np.testing.assert_array_equal(cat.getCentroidFlag(), [r.getCentroidFlag() for r in expected])
+            self.assertFloatsEqual(cat.getIxx(), [r.getIxx() for r in expected])
+            self.assertFloatsEqual(cat.getIyy(), [r.getIyy() for r in expected])
+            self.assertFloatsEqual(cat.getIxy(), [r.getIxy() for r in expected])
+            np.testing.assert_array_equal(cat.getShapeFlag(), [r.getShapeFlag() for r in expected])
+            self.assertFloatsEqual(cat.getPsfIxx(), [r.getPsfIxx() for r in expected])
+            np.testing.assert_array_equal(cat.getPsfShapeFlag(), [r.getPsfShapeFlag() for r in expected])
+        # Gathered columns don't share memory with the catalog.
+        self.assertFalse(catalog.getX().flags.writeable)
+
+        catalog.table.schema.getAliasMap().erase("slot_Centroid")
+        catalog.table.schema.getAliasMap().erase("slot_PsfShape")
+        for quantity in ["X", "Y", "CentroidFlag", "PsfIxx", "PsfShapeFlag"]:
+            with self.assertRaises(lsst.pex.exceptions.LogicError):
+                getattr(catalog, f"get{quantity}")()
+
     def testForwarding(self):
         """Verify that Catalog forwards unknown methods to its table and/or columns."""
         self.table.definePsfFlux("a")
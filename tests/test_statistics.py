@@ -577,6 +577,57 @@ class StatisticsTestCase(lsst.utils.tests.TestCase):
             self.assertEqual(afwMath.makeStatistics(image, mask, afwMath.NMASKED, ctrl).getValue(), 1)
 
 
+    def testQuantileTolerance(self):
+        """Test estimating quantiles from histograms"""
+        tolerance = 1e-3
+        exact = afwMath.StatisticsControl()
+        approx = afwMath.StatisticsControl()
+        self.assertEqual(approx.getQuantileTolerance(), 0.0)
+        approx.setQuantileTolerance(tolerance)
+        self.assertEqual(approx.getQuantileTolerance(), tolerance)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            approx.setQuantileTolerance(-1.0)
+
+        flags = afwMath.MEDIAN | afwMath.IQRANGE | afwMath.MEANCLIP | afwMath.NCLIPPED
+        for image, isInt, mean, median, std in self.images:
+            # Outliers inflate the standard deviation, but not the quantiles
+            image.array[:20, :] = 1000*mean
+            mask = afwImage.Mask(image.getBBox())
+            mask.array[20:40, :] = mask.getPlaneBitMask("BAD")
+            exact.setAndMask(mask.getPlaneBitMask("BAD"))
+            approx.setAndMask(mask.getPlaneBitMask("BAD"))
+            expected = afwMath.makeStatistics(image, mask, flags, exact)
+            stats = afwMath.makeStatistics(image, mask, flags, approx)
+            if isInt:
+                # Integer images always use the exact calculation
+                self.assertEqual(stats.getValue(afwMath.MEDIAN), expected.getValue(afwMath.MEDIAN))
+                self.assertEqual(stats.getValue(afwMath.IQRANGE), expected.getValue(afwMath.IQRANGE))
+                continue
+            self.assertFloatsAlmostEqual(stats.getValue(afwMath.MEDIAN), expected.getValue(afwMath.MEDIAN),
+                                         atol=tolerance*std)
+            self.assertFloatsAlmostEqual(stats.getValue(afwMath.IQRANGE), expected.getValue(afwMath.IQRANGE),
+                                         atol=2*tolerance*std)
+            self.assertFloatsAlmostEqual(stats.getValue(afwMath.MEANCLIP),
+                                         expected.getValue(afwMath.MEANCLIP), atol=1e-4)
+            self.assertAlmostEqual(stats.getValue(afwMath.NCLIPPED), expected.getValue(afwMath.NCLIPPED),
+                                   delta=5)
+
+            # Median alone
+            stats = afwMath.makeStatistics(image, mask, afwMath.MEDIAN, approx)
+            self.assertFloatsAlmostEqual(stats.getValue(), expected.getValue(afwMath.MEDIAN),
+                                         atol=tolerance*std)
+
+    def testQuantileToleranceConstant(self):
+        """Test that a constant image falls back to the exact calculation"""
+        ctrl = afwMath.StatisticsControl()
+        ctrl.setQuantileTolerance(1e-3)
+        image = afwImage.ImageF(10, 10)
+        image.set(3.25)
+        stats = afwMath.makeStatistics(image, afwMath.MEDIAN | afwMath.IQRANGE, ctrl)
+        self.assertEqual(stats.getValue(afwMath.MEDIAN), 3.25)
+        self.assertEqual(stats.getValue(afwMath.IQRANGE), 0.0)
+
+
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
 
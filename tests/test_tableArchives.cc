@@ -344,6 +344,22 @@ std::vector<ndarray::Vector<std::shared_ptr<Comparable>, M>> roundtripAndCompare
         outputs.back()[i] = outObj;
     }
 
+    // Round-trip and compare once more, reading data catalogs only as they are needed; the file must stay
+    // open until all objects are loaded, and its HDU should not be moved by loading them.
+    outputs.push_back(ndarray::Vector<std::shared_ptr<Comparable>, M>());
+    fits::Fits inFits3(manager, "r", fits::Fits::AUTO_CHECK);
+    inFits3.setHdu(fits::DEFAULT_HDU);
+    int const indexHdu = inFits3.getHdu();
+    InputArchive inArchive3 = InputArchive::readFitsLazy(inFits3);
+    for (int i = M - 1; i >= 0; --i) {
+        std::shared_ptr<Comparable> outObj =
+                std::dynamic_pointer_cast<Comparable>(inArchive3.get(inputIds[i]));
+        BOOST_CHECK_EQUAL(*outObj, *inputs[i]);
+        BOOST_CHECK_EQUAL(inFits3.getHdu(), indexHdu);
+        outputs.back()[i] = outObj;
+    }
+    inFits3.closeFile();
+
     return outputs;
 }
 
@@ -21,6 +21,7 @@ see <http://www.lsstcorp.org/LegalNotices/>.
 """
 import unittest
 
+import numpy as np
 from numpy.testing import assert_allclose
 import astshim as ast
 from astshim.test import makeForwardPolyMap
@@ -90,6 +91,33 @@ class TransformTestCase(TransformTestBaseClass):
         assert_allclose(merged1.applyForward(inPoint),
                         merged2.applyForward(inPoint))
 
+    def testLinearMappings(self):
+        """Test that linear mappings, which are evaluated without AST, give
+        the same results as AST"""
+        rng = np.random.RandomState(5)
+        matrix = ast.MatrixMap(np.array([[1.5, -0.3, 0.2], [0.1, 2.0, -0.7]]))
+        shift = ast.ShiftMap([1.0e4, -3.2e3])
+        mappings = [
+            ast.ZoomMap(3, 0.25),
+            ast.ShiftMap([12.5, -3.0]).then(ast.ZoomMap(2, 1.7)),
+            matrix.then(shift),
+            ast.MatrixMap(np.array([[1.1, 0.2], [-0.3, 0.9]])).then(shift),
+            makeForwardPolyMap(2, 2),  # not linear: evaluated by AST
+        ]
+        for mapping in mappings:
+            with self.subTest(mapping=mapping):
+                transform = afwGeom.TransformGenericToGeneric(mapping)
+                points = rng.uniform(-5000.0, 5000.0, (mapping.nIn, 50))
+                expected = transform.getMapping().applyForward(points)
+                assert_allclose(transform.applyForward(points), expected, rtol=1e-12, atol=1e-9)
+                for point in points.T:
+                    assert_allclose(transform.applyForward(point), transform.getMapping().applyForward(point),
+                                    rtol=1e-12, atol=1e-9)
+                if mapping.hasInverse:
+                    assert_allclose(transform.applyInverse(expected), points, rtol=1e-10, atol=1e-8)
+                    assert_allclose(transform.inverted().applyForward(expected), points, rtol=1e-10,
+                                    atol=1e-8)
+
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass